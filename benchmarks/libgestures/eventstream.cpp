@@ -0,0 +1,184 @@
+#include "eventstream.h"
+
+namespace libgestures
+{
+
+/**
+ * Interval between events of synthetic streams, roughly the rate at which touchpads send gesture events.
+ */
+static constexpr std::chrono::milliseconds s_eventInterval(10);
+
+/**
+ * Assigns timestamps to the events of a synthetic stream.
+ */
+static EventStream timed(EventStream stream)
+{
+    for (size_t i = 0; i < stream.size(); i++) {
+        stream[i].time = i * s_eventInterval;
+    }
+    return stream;
+}
+
+EventStream EventStreams::swipe(const uint8_t &fingers, const QPointF &delta, const uint32_t &updates)
+{
+    EventStream stream;
+    stream.push_back({.type = EventType::SwipeBegin, .fingers = fingers});
+    for (uint32_t i = 0; i < updates; i++) {
+        stream.push_back({.type = EventType::SwipeUpdate, .fingers = fingers, .delta = delta});
+    }
+    stream.push_back({.type = EventType::SwipeEnd, .fingers = fingers});
+    return timed(std::move(stream));
+}
+
+EventStream EventStreams::pinch(const uint8_t &fingers, const qreal &scaleDelta, const uint32_t &updates)
+{
+    EventStream stream;
+    stream.push_back({.type = EventType::PinchBegin, .fingers = fingers});
+    qreal scale = 1;
+    for (uint32_t i = 0; i < updates; i++) {
+        scale += scaleDelta;
+        stream.push_back({.type = EventType::PinchUpdate, .fingers = fingers, .scale = scale});
+    }
+    stream.push_back({.type = EventType::PinchEnd, .fingers = fingers});
+    return timed(std::move(stream));
+}
+
+EventStream EventStreams::rotate(const uint8_t &fingers, const qreal &angleDelta, const uint32_t &updates)
+{
+    EventStream stream;
+    stream.push_back({.type = EventType::PinchBegin, .fingers = fingers});
+    for (uint32_t i = 0; i < updates; i++) {
+        stream.push_back({.type = EventType::PinchUpdate, .fingers = fingers, .scale = 1, .angleDelta = angleDelta});
+    }
+    stream.push_back({.type = EventType::PinchEnd, .fingers = fingers});
+    return timed(std::move(stream));
+}
+
+EventStream EventStreams::hold(const uint8_t &fingers, const std::chrono::microseconds &interval, const uint32_t &updates)
+{
+    EventStream stream;
+    stream.push_back({.type = EventType::HoldBegin, .fingers = fingers});
+    for (uint32_t i = 1; i <= updates; i++) {
+        stream.push_back({.type = EventType::HoldUpdate, .fingers = fingers, .time = i * interval});
+    }
+    stream.push_back({.type = EventType::HoldEnd, .fingers = fingers, .time = updates * interval});
+    return stream;
+}
+
+EventStream EventStreams::trace(const std::vector<TraceRecord> &records)
+{
+    EventStream stream;
+    stream.reserve(records.size());
+    for (const auto &record : records) {
+        Event event{.fingers = record.fingers,
+                    .time = std::chrono::microseconds(record.time),
+                    .delta = QPointF(record.deltaX, record.deltaY),
+                    .scale = record.scale,
+                    .angleDelta = record.angleDelta};
+        switch (record.type) {
+        case TraceEventType::HoldBegin:
+            event.type = EventType::HoldBegin;
+            break;
+        case TraceEventType::HoldUpdate:
+            event.type = EventType::HoldUpdate;
+            break;
+        case TraceEventType::HoldEnd:
+            event.type = EventType::HoldEnd;
+            break;
+        case TraceEventType::HoldCancel:
+            event.type = EventType::HoldCancel;
+            break;
+        case TraceEventType::PinchBegin:
+            event.type = EventType::PinchBegin;
+            break;
+        case TraceEventType::PinchUpdate:
+            event.type = EventType::PinchUpdate;
+            break;
+        case TraceEventType::PinchEnd:
+            event.type = EventType::PinchEnd;
+            break;
+        case TraceEventType::PinchCancel:
+            event.type = EventType::PinchCancel;
+            break;
+        case TraceEventType::SwipeBegin:
+            event.type = EventType::SwipeBegin;
+            break;
+        case TraceEventType::SwipeUpdate:
+            event.type = EventType::SwipeUpdate;
+            break;
+        case TraceEventType::SwipeEnd:
+            event.type = EventType::SwipeEnd;
+            break;
+        case TraceEventType::SwipeCancel:
+            event.type = EventType::SwipeCancel;
+            break;
+        default:
+            // Unknown event types from newer versions are skipped
+            continue;
+        }
+        stream.push_back(event);
+    }
+    return stream;
+}
+
+void dispatch(GestureRecognizer &recognizer, const Event &event)
+{
+    bool endedPrematurely = false;
+    switch (event.type) {
+    case EventType::HoldBegin:
+        recognizer.holdGestureBegin(event.fingers, event.time);
+        break;
+    case EventType::HoldUpdate:
+        recognizer.holdGestureUpdate(event.time, endedPrematurely);
+        break;
+    case EventType::HoldEnd:
+        recognizer.holdGestureEnd(event.time);
+        break;
+    case EventType::HoldCancel:
+        recognizer.holdGestureCancel(event.time);
+        break;
+    case EventType::PinchBegin:
+        recognizer.pinchGestureBegin(event.fingers, event.time);
+        break;
+    case EventType::PinchUpdate:
+        recognizer.pinchGestureUpdate(event.scale, event.angleDelta, event.delta, event.time, endedPrematurely);
+        break;
+    case EventType::PinchEnd:
+        recognizer.pinchGestureEnd();
+        break;
+    case EventType::PinchCancel:
+        recognizer.pinchGestureCancel();
+        break;
+    case EventType::SwipeBegin:
+        recognizer.swipeGestureBegin(event.fingers, event.time);
+        break;
+    case EventType::SwipeUpdate:
+        recognizer.swipeGestureUpdate(event.delta, event.time, endedPrematurely);
+        break;
+    case EventType::SwipeEnd:
+        recognizer.swipeGestureEnd();
+        break;
+    case EventType::SwipeCancel:
+        recognizer.swipeGestureCancel();
+        break;
+    }
+
+    // Mirror the input filter, which ends the gesture immediately in this case
+    if (endedPrematurely) {
+        switch (event.type) {
+        case EventType::HoldUpdate:
+            recognizer.holdGestureEnd(event.time);
+            break;
+        case EventType::PinchUpdate:
+            recognizer.pinchGestureEnd();
+            break;
+        case EventType::SwipeUpdate:
+            recognizer.swipeGestureEnd();
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+}
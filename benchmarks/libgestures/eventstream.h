@@ -0,0 +1,77 @@
+#pragma once
+
+#include "libgestures/gestures/gesturerecognizer.h"
+#include "libgestures/trace.h"
+
+#include <QPointF>
+
+#include <chrono>
+#include <vector>
+
+namespace libgestures
+{
+
+enum class EventType : uint8_t {
+    HoldBegin,
+    HoldUpdate,
+    HoldEnd,
+    HoldCancel,
+    PinchBegin,
+    PinchUpdate,
+    PinchEnd,
+    PinchCancel,
+    SwipeBegin,
+    SwipeUpdate,
+    SwipeEnd,
+    SwipeCancel
+};
+
+/**
+ * A single touchpad event, as received by the input filter.
+ */
+struct Event
+{
+    EventType type;
+    uint8_t fingers = 0;
+    /**
+     * Timestamp of the event. Events of synthetic streams are 10 ms apart unless specified otherwise, starting at 0.
+     */
+    std::chrono::microseconds time{};
+
+    /**
+     * Swipe and pinch delta.
+     */
+    QPointF delta;
+    qreal scale = 1;
+    qreal angleDelta = 0;
+};
+
+using EventStream = std::vector<Event>;
+
+/**
+ * Synthetic event streams resembling what libinput sends for a single gesture.
+ */
+class EventStreams
+{
+public:
+    static EventStream swipe(const uint8_t &fingers, const QPointF &delta, const uint32_t &updates);
+    static EventStream pinch(const uint8_t &fingers, const qreal &scaleDelta, const uint32_t &updates);
+    static EventStream rotate(const uint8_t &fingers, const qreal &angleDelta, const uint32_t &updates);
+    /**
+     * @param interval Time between hold updates.
+     */
+    static EventStream hold(const uint8_t &fingers, const std::chrono::microseconds &interval, const uint32_t &updates);
+
+    /**
+     * Converts events recorded by the KWin effect (input_trace).
+     */
+    static EventStream trace(const std::vector<TraceRecord> &records);
+};
+
+/**
+ * Passes the event to the recognizer the same way the KWin input filter does.
+ * @remark The time of Clock should be set to the time of the event beforehand.
+ */
+void dispatch(GestureRecognizer &recognizer, const Event &event);
+
+}
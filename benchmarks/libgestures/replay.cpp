@@ -0,0 +1,264 @@
+#include "eventstream.h"
+#include "libgestures/actions/input.h"
+#include "libgestures/clock.h"
+#include "mockwindowinfoprovider.h"
+
+#include <QCommandLineParser>
+#include <QCoreApplication>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+using namespace libgestures;
+
+// Allocations are only counted while an event is being dispatched. Other threads, such as Qt's, allocate too.
+static std::atomic<uint64_t> s_allocations = 0;
+static std::atomic<bool> s_countAllocations = false;
+
+void *operator new(std::size_t size)
+{
+    if (s_countAllocations.load(std::memory_order_relaxed)) {
+        s_allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+/**
+ * Counts sent input instead of sending it.
+ */
+class MockInput : public Input
+{
+public:
+    void keyboardKey(const uint32_t &key, const bool &state) override
+    {
+        m_events++;
+    }
+    void mouseButton(const uint32_t &button, const bool &state) override
+    {
+        m_events++;
+    }
+    void mouseMoveAbsolute(const QPointF &pos) override
+    {
+        m_events++;
+    }
+    void mouseMoveRelative(const QPointF &pos) override
+    {
+        m_events++;
+    }
+
+    void beginBatch() override
+    {
+        if (m_batchDepth++ == 0) {
+            m_batches++;
+        }
+    }
+    void endBatch() override
+    {
+        m_batchDepth--;
+    }
+
+    uint64_t m_events = 0;
+    uint64_t m_batches = 0;
+
+private:
+    uint32_t m_batchDepth = 0;
+};
+
+/**
+ * Builds a configuration with the specified amount of gestures, spread over the specified types and all directions
+ * and finger counts, similar to what a large user configuration looks like. Every fourth gesture has a window class
+ * condition.
+ */
+static std::shared_ptr<GestureRecognizer> createRecognizer(const uint32_t &gestures, const std::vector<GestureType> &types)
+{
+    auto recognizer = std::make_shared<GestureRecognizer>();
+    const auto condition = std::make_shared<Condition>();
+    condition->setWindowClass(QRegularExpression("firefox|chromium"));
+
+    for (uint32_t i = 0; i < gestures; i++) {
+        // Index of the gesture among gestures of the same type
+        const auto n = i / types.size();
+        std::shared_ptr<Gesture> gesture;
+        switch (types[i % types.size()]) {
+        case GestureType::Swipe: {
+            auto swipe = std::make_shared<SwipeGesture>();
+            swipe->setDirection(static_cast<SwipeDirection>(n % 7));
+            gesture = swipe;
+            break;
+        }
+        case GestureType::Pinch: {
+            auto pinch = std::make_shared<PinchGesture>();
+            pinch->setDirection(static_cast<PinchDirection>(n % 3));
+            gesture = pinch;
+            break;
+        }
+        case GestureType::Rotate: {
+            auto rotate = std::make_shared<RotateGesture>();
+            rotate->setDirection(static_cast<RotateDirection>(n % 3));
+            gesture = rotate;
+            break;
+        }
+        case GestureType::Hold:
+            gesture = std::make_shared<HoldGesture>();
+            break;
+        }
+        const uint8_t fingers = 2 + n / 7 % 3;
+        gesture->setFingers(fingers, fingers);
+        if (i % 4 == 0) {
+            gesture->addCondition(condition);
+        }
+
+        auto action = std::make_shared<InputGestureAction>();
+        action->setOn(i % 2 ? On::End : On::Update);
+        action->setRepeatInterval(i % 2 ? 0 : 10);
+        action->setSequence({InputAction{.keyboardPress = {KEY_LEFTCTRL, KEY_N}, .keyboardRelease = {KEY_N, KEY_LEFTCTRL}}});
+        gesture->addAction(action);
+
+        recognizer->registerGesture(gesture);
+    }
+    return recognizer;
+}
+
+/**
+ * Streams of every gesture type with 2 to 4 fingers.
+ */
+static EventStream createEventStream()
+{
+    EventStream events;
+    const auto append = [&events](const EventStream &stream) {
+        events.insert(events.end(), stream.begin(), stream.end());
+    };
+    for (uint8_t fingers = 2; fingers <= 4; fingers++) {
+        append(EventStreams::swipe(fingers, QPointF(4, 0.5), 50));
+        append(EventStreams::swipe(fingers, QPointF(0, -25), 10));
+        append(EventStreams::pinch(fingers, 0.01, 50));
+        append(EventStreams::pinch(fingers, -0.01, 50));
+        append(EventStreams::rotate(fingers, 2, 50));
+        append(EventStreams::hold(fingers, std::chrono::milliseconds(5), 100));
+    }
+    return events;
+}
+
+int main(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    QCommandLineParser parser;
+    parser.setApplicationDescription("Replays touchpad event streams through GestureRecognizer and reports the cost per event.");
+    parser.addHelpOption();
+    const QCommandLineOption iterationsOption("iterations", "How many times to replay the event streams for every configuration size.", "count", "100");
+    const QCommandLineOption gesturesOption("gestures", "Comma-separated configuration sizes.", "sizes", "1,10,100,1000");
+    const QCommandLineOption typesOption("types",
+                                         "Comma-separated gesture types (hold, pinch, rotate, swipe) the configurations consist of. A configuration "
+                                         "of only swipe gestures measures how gestures that stop matching once the direction is locked are "
+                                         "filtered.",
+                                         "types", "swipe,pinch,rotate,hold");
+    const QCommandLineOption traceOption("trace", "Replay events recorded by the KWin effect (input_trace) instead of synthetic event streams.", "file");
+    parser.addOption(iterationsOption);
+    parser.addOption(gesturesOption);
+    parser.addOption(typesOption);
+    parser.addOption(traceOption);
+    parser.process(app);
+
+    const auto iterations = parser.value(iterationsOption).toUInt();
+    if (iterations == 0) {
+        std::fprintf(stderr, "Invalid iteration count: %s\n", qPrintable(parser.value(iterationsOption)));
+        return 1;
+    }
+    std::vector<GestureType> types;
+    for (const auto &type : parser.value(typesOption).split(',')) {
+        if (type == "hold") {
+            types.push_back(GestureType::Hold);
+        } else if (type == "pinch") {
+            types.push_back(GestureType::Pinch);
+        } else if (type == "rotate") {
+            types.push_back(GestureType::Rotate);
+        } else if (type == "swipe") {
+            types.push_back(GestureType::Swipe);
+        } else {
+            std::fprintf(stderr, "Invalid gesture type: %s\n", qPrintable(type));
+            return 1;
+        }
+    }
+    // Events are replayed much faster than they were recorded, time is taken from the events instead
+    auto clock = new VirtualClock;
+    Clock::setImplementation(clock);
+    auto input = new MockInput;
+    Input::setImplementation(input);
+    WindowInfoProvider::setImplementation(new MockWindowInfoProvider(WindowInfo("Firefox", "firefox", "firefox", static_cast<WindowState>(0))));
+
+    EventStream events;
+    if (parser.isSet(traceOption)) {
+        const auto records = readTrace(parser.value(traceOption));
+        if (!records) {
+            std::fprintf(stderr, "Failed to read trace: %s\n", qPrintable(parser.value(traceOption)));
+            return 1;
+        }
+        events = EventStreams::trace(records.value());
+    } else {
+        events = createEventStream();
+    }
+    if (events.empty()) {
+        std::fprintf(stderr, "No events to replay\n");
+        return 1;
+    }
+    std::vector<uint64_t> latencies;
+    latencies.reserve(events.size() * iterations);
+
+    std::printf("%10s %12s %12s %12s %12s\n", "gestures", "events", "ns/event", "allocs/event", "p99 ns");
+    for (const auto &gesturesRaw : parser.value(gesturesOption).split(',')) {
+        const auto gestures = gesturesRaw.toUInt();
+        const auto recognizer = createRecognizer(gestures, types);
+
+        // Warm up caches and lazily initialized state
+        for (const auto &event : events) {
+            clock->setTime(event.time);
+            dispatch(*recognizer, event);
+        }
+
+        latencies.clear();
+        s_allocations = 0;
+        uint64_t total = 0;
+        for (uint32_t i = 0; i < iterations; i++) {
+            for (const auto &event : events) {
+                clock->setTime(event.time);
+                s_countAllocations.store(true, std::memory_order_relaxed);
+                const auto start = std::chrono::steady_clock::now();
+                dispatch(*recognizer, event);
+                const auto end = std::chrono::steady_clock::now();
+                s_countAllocations.store(false, std::memory_order_relaxed);
+
+                const auto latency = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+                latencies.push_back(latency);
+                total += latency;
+            }
+        }
+
+        const auto count = latencies.size();
+        const auto p99 = latencies.begin() + std::min(count - 1, count * 99 / 100);
+        std::nth_element(latencies.begin(), p99, latencies.end());
+        std::printf("%10u %12zu %12.1f %12.3f %12lu\n", gestures, count, static_cast<double>(total) / count,
+                    static_cast<double>(s_allocations) / count, static_cast<unsigned long>(*p99));
+    }
+
+    // Prevent the input from being optimized away
+    std::fprintf(stderr, "%lu input events sent in %lu batches\n", static_cast<unsigned long>(input->m_events),
+                 static_cast<unsigned long>(input->m_batches));
+    return 0;
+}
@@ -2,14 +2,26 @@
 #include "libgestures/yaml_convert.h"
 
 #include <QDir>
+#include <QFile>
 #include <QLoggingCategory>
 
 Q_LOGGING_CATEGORY(KWIN_GESTURES, "kwin_gestures", QtWarningMsg)
 
 const QString configFile = QStandardPaths::writableLocation(QStandardPaths::ConfigLocation) + "/kwingestures.yml";
+/**
+ * How long to wait for further file watcher events before reloading the configuration, in milliseconds. Editors often
+ * emit multiple events for a single save.
+ */
+static const int s_configReloadDelay = 100;
 
 Effect::Effect()
 {
+    m_configThreadPool.setMaxThreadCount(1);
+    m_configReloadTimer.setSingleShot(true);
+    m_configReloadTimer.setInterval(s_configReloadDelay);
+    connect(&m_configReloadTimer, &QTimer::timeout, this, [this]() {
+        load(false);
+    });
     libgestures::Input::setImplementation(new KWinInput);
     libgestures::WindowInfoProvider::setImplementation(new KWinWindowInfoProvider);
 
@@ -32,6 +44,9 @@ Effect::Effect()
 
 Effect::~Effect()
 {
+    // Pending configurations are delivered to this object
+    m_configThreadPool.waitForDone();
+
     if (KWin::input()) {
         KWin::input()->uninstallInputEventFilter(m_inputEventFilter.get());
     }
@@ -44,7 +59,7 @@ void Effect::slotConfigFileChanged()
     }
 
     if (m_autoReload) {
-        reconfigure(ReconfigureAll);
+        scheduleReload();
     }
 }
 
@@ -53,7 +68,7 @@ void Effect::slotConfigDirectoryChanged()
     if (!m_configFileWatcher.files().contains(configFile) && QFile::exists(configFile)) {
         m_configFileWatcher.addPath(configFile);
         if (m_autoReload) {
-            reconfigure(ReconfigureAll);
+            scheduleReload();
         }
     }
 }
@@ -62,13 +77,96 @@ void Effect::reconfigure(ReconfigureFlags flags)
 {
     Q_UNUSED(flags)
 
+    m_configReloadTimer.stop();
+    load(true);
+}
+
+void Effect::scheduleReload()
+{
+    m_configReloadTimer.start();
+}
+
+void Effect::load(const bool &force)
+{
+    const auto generation = ++m_configGeneration;
+    auto *mainThread = thread();
+    const auto previousHash = force ? QByteArray() : m_configHash;
+    // Reused gestures are shared with the current recognizer, so none are reused while a gesture is in progress. A
+    // gesture beginning after this point is safe, as the new recognizer is only swapped in once no gesture is active.
+    auto previous = m_inputEventFilter->hasActiveGestures() ? nullptr : m_config;
+    m_configThreadPool.start([this, generation, mainThread, previousHash, previous = std::move(previous)]() mutable {
+        std::shared_ptr<libgestures::Config> config;
+        QByteArray hash;
+
+        // A file that hasn't changed since the cache was created is neither read nor hashed
+        const libgestures::ConfigCache cache(configFile);
+        std::optional<libgestures::Config> loadedConfig;
+        auto key = cache.unchangedKey();
+        if (key && key->hash != previousHash) {
+            loadedConfig = cache.load(*key, previous.get());
+        }
+        if (!key || (key->hash != previousHash && !loadedConfig)) {
+            QFile file(configFile);
+            if (file.open(QIODevice::ReadOnly)) {
+                const auto content = file.readAll();
+                // The cache has already failed to load if it was created from the same contents
+                const auto failedKey = std::exchange(key, cache.key(content));
+                if (key->hash != previousHash) {
+                    if (!failedKey || failedKey->hash != key->hash) {
+                        loadedConfig = cache.load(*key, previous.get());
+                    }
+                    if (!loadedConfig) {
+                        loadedConfig = loadConfig(cache, content, *key, previous.get());
+                    }
+                }
+            } else {
+                qCritical(KWIN_GESTURES).noquote() << QStringLiteral("Failed to open configuration file ") + configFile;
+            }
+        }
+
+        if (loadedConfig) {
+            // Gestures and actions must live in the thread that handles input
+            loadedConfig->moveToThread(mainThread);
+            config = std::make_shared<libgestures::Config>(std::move(loadedConfig.value()));
+            hash = key->hash;
+        }
+
+        // Both configurations are passed back, so that objects living in the main thread are never destroyed here
+        QMetaObject::invokeMethod(this, [this, generation, config = std::move(config), hash, previous = std::move(previous)]() {
+            if (config && generation == m_configGeneration) {
+                m_configHash = hash;
+                applyConfig(config);
+            }
+        }, Qt::QueuedConnection);
+    });
+}
+
+std::optional<libgestures::Config> Effect::loadConfig(const libgestures::ConfigCache &cache, const QByteArray &content,
+                                                     const libgestures::ConfigCache::Key &key, const libgestures::Config *previous)
+{
+    std::optional<libgestures::Config> config;
     try {
-        const auto config = YAML::LoadFile(configFile.toStdString());
-        m_autoReload = config["autoreload"].as<bool>(true);
-        auto gestureRecognizer = config["touchpad"].as<std::shared_ptr<libgestures::GestureRecognizer>>();
-        m_inputEventFilter->setTouchpadGestureRecognizer(gestureRecognizer);
+        config.emplace();
+        YAML::convert<libgestures::Config>::decode(YAML::Load(content.toStdString()), config.value(), previous);
     } catch (const YAML::Exception &e) {
         qCritical(KWIN_GESTURES).noquote() << QStringLiteral("Failed to load configuration: ") + QString::fromStdString(e.msg)
                 + " (line " + QString::number(e.mark.line) + ", column " + QString::number(e.mark.column) + ")";
+        return std::nullopt;
+    }
+
+    if (!cache.save(key, config.value())) {
+        qWarning(KWIN_GESTURES).noquote() << QStringLiteral("Failed to write configuration cache ") + cache.path();
     }
-}
\ No newline at end of file
+    return config;
+}
+
+void Effect::applyConfig(const std::shared_ptr<libgestures::Config> &config)
+{
+    m_config = config;
+    m_autoReload = config->autoReload;
+    libgestures::CommandExecutor::instance()->setConcurrencyLimit(config->commandConcurrency);
+    m_inputEventFilter->setTouchpadGestureRecognizer(config->touchpadGestureRecognizer);
+    if (!m_inputEventFilter->setInputTrace(config->inputTrace)) {
+        qWarning(KWIN_GESTURES).noquote() << QStringLiteral("Failed to open input trace ") + config->inputTrace;
+    }
+}
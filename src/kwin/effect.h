@@ -4,8 +4,11 @@
 #include "impl/kwininput.h"
 #include "impl/kwinwindowinfoprovider.h"
 #include "inputfilter.h"
+#include "libgestures/configcache.h"
 
 #include <QFileSystemWatcher>
+#include <QThreadPool>
+#include <QTimer>
 
 class Effect : public KWin::Effect
 {
@@ -22,6 +25,9 @@ public:
         return false;
     };
 
+    /**
+     * Loads the configuration on a worker thread and applies it once loaded, even if the file hasn't changed.
+     */
     void reconfigure(ReconfigureFlags flags) override;
 
 private slots:
@@ -29,7 +35,46 @@ private slots:
     void slotConfigDirectoryChanged();
 
 private:
+    /**
+     * Restarts the reload timer, coalescing bursts of file watcher events into a single reload.
+     */
+    void scheduleReload();
+
+    /**
+     * Loads the configuration on a worker thread and applies it once loaded.
+     * @param force Whether to load the configuration even if the file's contents haven't changed since the last
+     * successful load.
+     */
+    void load(const bool &force);
+
+    /**
+     * Parses the contents of the configuration file and saves the result to the cache. Called on a worker thread.
+     * @param previous The currently applied configuration. Unchanged gestures are taken from it instead of being
+     * created again. nullptr if a gesture was in progress when loading began.
+     */
+    static std::optional<libgestures::Config> loadConfig(const libgestures::ConfigCache &cache, const QByteArray &content,
+                                                         const libgestures::ConfigCache::Key &key, const libgestures::Config *previous);
+    void applyConfig(const std::shared_ptr<libgestures::Config> &config);
+
     bool m_autoReload = true;
     std::unique_ptr<GestureInputEventFilter> m_inputEventFilter = std::make_unique<GestureInputEventFilter>();
     QFileSystemWatcher m_configFileWatcher;
+    QTimer m_configReloadTimer;
+
+    /**
+     * Single thread, so that configurations are loaded in the order reconfigure was called.
+     */
+    QThreadPool m_configThreadPool;
+    /**
+     * Incremented on every reconfigure. Loaded configurations are only applied if no reconfigure happened since.
+     */
+    uint64_t m_configGeneration = 0;
+    /**
+     * Hash of the contents of the configuration file the current configuration was loaded from.
+     */
+    QByteArray m_configHash;
+    /**
+     * The currently applied configuration.
+     */
+    std::shared_ptr<libgestures::Config> m_config;
 };
\ No newline at end of file
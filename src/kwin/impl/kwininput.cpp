@@ -32,7 +32,7 @@ KWinInput::~KWinInput()
 void KWinInput::keyboardKey(const uint32_t &key, const bool &state)
 {
     m_ignoreModifierUpdates = true;
-    m_keyboard->processKey(key, state ? KeyboardKeyStatePressed : KeyboardKeyStateReleased, timestamp(), m_device.get());
+    m_keyboard->processKey(key, state ? KeyboardKeyStatePressed : KeyboardKeyStateReleased, eventTime(), m_device.get());
     m_ignoreModifierUpdates = false;
 }
 
@@ -50,6 +50,7 @@ void KWinInput::keyboardClearModifiers()
         KWin::workspace()->disableGlobalShortcutsForClient(true);
     }
 
+    const libgestures::InputBatch batch;
     // These events will belong to a different device, which wouldn't work with normal keys, but it works with modifiers.
     // The user should be able to start the gesture again while still having the modifiers pressed, so the previous
     // ones must be kept track of.
@@ -69,19 +70,48 @@ void KWinInput::keyboardClearModifiers()
 
 void KWinInput::mouseButton(const uint32_t &button, const bool &state)
 {
-    m_pointer->processButton(button, state ? PointerButtonStatePressed : PointerButtonStateReleased, timestamp(), m_device.get());
-    m_pointer->processFrame(m_device.get());
+    m_pointer->processButton(button, state ? PointerButtonStatePressed : PointerButtonStateReleased, eventTime(), m_device.get());
+    pointerFrame();
 }
 
 void KWinInput::mouseMoveAbsolute(const QPointF &pos)
 {
-    m_pointer->processMotionAbsolute(pos, timestamp(), m_device.get());
-    m_pointer->processFrame(m_device.get());
+    m_pointer->processMotionAbsolute(pos, eventTime(), m_device.get());
+    pointerFrame();
 }
 
 void KWinInput::mouseMoveRelative(const QPointF &pos)
 {
-    m_pointer->processMotion(pos, pos, timestamp(), m_device.get());
+    m_pointer->processMotion(pos, pos, eventTime(), m_device.get());
+    pointerFrame();
+}
+
+void KWinInput::beginBatch()
+{
+    if (m_batchDepth++ == 0) {
+        m_batchTime = timestamp();
+    }
+}
+
+void KWinInput::endBatch()
+{
+    if (--m_batchDepth == 0 && m_pointerFramePending) {
+        m_pointerFramePending = false;
+        m_pointer->processFrame(m_device.get());
+    }
+}
+
+std::chrono::microseconds KWinInput::eventTime() const
+{
+    return m_batchDepth ? m_batchTime : timestamp();
+}
+
+void KWinInput::pointerFrame()
+{
+    if (m_batchDepth) {
+        m_pointerFramePending = true;
+        return;
+    }
     m_pointer->processFrame(m_device.get());
 }
 
@@ -56,10 +56,22 @@ public:
     void mouseMoveAbsolute(const QPointF &pos) override;
     void mouseMoveRelative(const QPointF &pos) override;
 
+    void beginBatch() override;
+    void endBatch() override;
+
 private slots:
     void slotKeyStateChanged(quint32 keyCode, KeyboardKeyState state);
 
 private:
+    /**
+     * @return The timestamp of the current batch, or the current time if no batch is in progress.
+     */
+    std::chrono::microseconds eventTime() const;
+    /**
+     * Ends the current pointer frame, or defers it to the end of the current batch.
+     */
+    void pointerFrame();
+
     KWin::InputRedirection *m_input;
     KWin::PointerInputRedirection *m_pointer;
     KWin::KeyboardInputRedirection *m_keyboard;
@@ -67,4 +79,8 @@ private:
 
     Qt::KeyboardModifiers m_modifiers = Qt::KeyboardModifier::NoModifier;
     bool m_ignoreModifierUpdates = false;
+
+    uint32_t m_batchDepth = 0;
+    std::chrono::microseconds m_batchTime{};
+    bool m_pointerFramePending = false;
 };
\ No newline at end of file
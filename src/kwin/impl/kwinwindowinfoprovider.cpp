@@ -2,6 +2,12 @@
 #include "effect/effecthandler.h"
 #include "window.h"
 
+KWinWindowInfoProvider::KWinWindowInfoProvider()
+{
+    connect(KWin::effects, &KWin::EffectsHandler::windowActivated, this, &KWinWindowInfoProvider::slotWindowActivated);
+    slotWindowActivated(KWin::effects->activeWindow());
+}
+
 std::optional<const libgestures::WindowInfo> KWinWindowInfoProvider::activeWindow() const
 {
     const auto window = KWin::effects->activeWindow();
@@ -15,4 +21,28 @@ std::optional<const libgestures::WindowInfo> KWinWindowInfoProvider::activeWindo
         state = state | libgestures::WindowState::Maximized;
 
     return libgestures::WindowInfo(window->caption(), window->window()->resourceClass(), window->window()->resourceName(), state);
-}
\ No newline at end of file
+}
+
+void KWinWindowInfoProvider::slotWindowActivated(KWin::EffectWindow *window)
+{
+    for (const auto &connection : m_activeWindowConnections) {
+        disconnect(connection);
+    }
+    m_activeWindowConnections.clear();
+    invalidateActiveWindow();
+
+    if (!window)
+        return;
+
+    const auto invalidate = [this]() {
+        invalidateActiveWindow();
+    };
+    const auto kwinWindow = window->window();
+    m_activeWindowConnections = {
+        connect(kwinWindow, &KWin::Window::captionChanged, this, invalidate),
+        connect(kwinWindow, &KWin::Window::windowClassChanged, this, invalidate),
+        connect(kwinWindow, &KWin::Window::maximizedChanged, this, invalidate),
+        connect(kwinWindow, &KWin::Window::fullScreenChanged, this, invalidate),
+        connect(kwinWindow, &QObject::destroyed, this, invalidate),
+    };
+}
@@ -2,10 +2,27 @@
 
 #include "libgestures/windowinfoprovider.h"
 
-class KWinWindowInfoProvider : public libgestures::WindowInfoProvider
+#include <QObject>
+
+namespace KWin
+{
+class EffectWindow;
+}
+
+class KWinWindowInfoProvider : public QObject, public libgestures::WindowInfoProvider
 {
+    Q_OBJECT
 public:
-    KWinWindowInfoProvider() = default;
+    KWinWindowInfoProvider();
 
     std::optional<const libgestures::WindowInfo> activeWindow() const override;
-};
\ No newline at end of file
+
+private slots:
+    /**
+     * Invalidates the cache and starts watching the new active window for changes.
+     */
+    void slotWindowActivated(KWin::EffectWindow *window);
+
+private:
+    std::vector<QMetaObject::Connection> m_activeWindowConnections;
+};
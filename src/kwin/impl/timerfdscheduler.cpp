@@ -0,0 +1,46 @@
+#include "timerfdscheduler.h"
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+
+TimerFdScheduler::TimerFdScheduler()
+    : m_fd(timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC))
+{
+    if (m_fd == -1) {
+        return;
+    }
+
+    m_notifier = std::make_unique<QSocketNotifier>(m_fd, QSocketNotifier::Read);
+    connect(m_notifier.get(), &QSocketNotifier::activated, this, &TimerFdScheduler::slotActivated);
+}
+
+TimerFdScheduler::~TimerFdScheduler()
+{
+    m_notifier = nullptr;
+    if (m_fd != -1) {
+        close(m_fd);
+    }
+}
+
+void TimerFdScheduler::armTimer(const std::chrono::microseconds &deadline)
+{
+    if (m_fd == -1) {
+        return;
+    }
+
+    // A zero expiration time would disarm the timer
+    const auto nanoseconds = std::max<int64_t>(std::chrono::nanoseconds(deadline).count(), 1);
+    itimerspec spec{};
+    spec.it_value.tv_sec = nanoseconds / 1'000'000'000;
+    spec.it_value.tv_nsec = nanoseconds % 1'000'000'000;
+    timerfd_settime(m_fd, TFD_TIMER_ABSTIME, &spec, nullptr);
+}
+
+void TimerFdScheduler::slotActivated()
+{
+    uint64_t expirations;
+    if (read(m_fd, &expirations, sizeof(expirations)) != sizeof(expirations)) {
+        return;
+    }
+    run();
+}
@@ -0,0 +1,30 @@
+#pragma once
+
+#include "libgestures/scheduler.h"
+
+#include <QObject>
+#include <QSocketNotifier>
+
+/**
+ * Scheduler backed by a single timerfd on the monotonic clock, which is watched by the event loop.
+ *
+ * @remark Requires the default libgestures::Clock implementation.
+ */
+class TimerFdScheduler : public QObject, public libgestures::Scheduler
+{
+    Q_OBJECT
+
+public:
+    TimerFdScheduler();
+    ~TimerFdScheduler() override;
+
+protected:
+    void armTimer(const std::chrono::microseconds &deadline) override;
+
+private slots:
+    void slotActivated();
+
+private:
+    int m_fd = -1;
+    std::unique_ptr<QSocketNotifier> m_notifier;
+};
@@ -2,6 +2,8 @@
 
 #include "utils.h"
 
+#include "libgestures/input.h"
+
 #ifndef KWIN_6_3_OR_GREATER
 #include "core/inputdevice.h"
 #endif
@@ -9,71 +11,138 @@
 #include "input_event_spy.h"
 #include "wayland_server.h"
 
-static uint32_t s_scrollTimeout = 100;
-static qreal s_holdDelta = 5;
 
 GestureInputEventFilter::GestureInputEventFilter()
 #ifdef KWIN_6_2_OR_GREATER
     : KWin::InputEventFilter(KWin::InputFilterOrder::TabBox)
 #endif
 {
-    m_touchpadHoldGestureTimer.setTimerType(Qt::PreciseTimer);
-    connect(&m_touchpadHoldGestureTimer, &QTimer::timeout, this, [this]() {
-        holdGestureUpdate(s_holdDelta);
+    m_touchpadHoldGestureUpdateTask = m_scheduler.addTask([this]() {
+        holdGestureUpdate();
     });
-
-    m_scrollTimer.setSingleShot(true);
-    connect(&m_scrollTimer, &QTimer::timeout, this, [this]() {
+    m_scrollEndTask = m_scheduler.addTask([this]() {
         swipeGestureEnd(timestamp());
     });
 }
 
 void GestureInputEventFilter::setTouchpadGestureRecognizer(const std::shared_ptr<libgestures::GestureRecognizer> &gestureRecognizer)
 {
-    m_touchpadGestureRecognizer = gestureRecognizer;
+    m_pendingTouchpadGestureRecognizer = gestureRecognizer;
 }
 
-bool GestureInputEventFilter::holdGestureBegin(int fingerCount, std::chrono::microseconds time)
+bool GestureInputEventFilter::hasActiveGestures() const
+{
+    return m_touchpadGestureRecognizer->hasActiveGestures();
+}
+
+void GestureInputEventFilter::applyPendingTouchpadGestureRecognizer()
+{
+    // Gestures of another type may still be active, for example a hold gesture when scrolling begins. Their remaining
+    // events must reach the recognizer they began in.
+    if (m_pendingTouchpadGestureRecognizer && !m_touchpadGestureRecognizer->hasActiveGestures()) {
+        m_touchpadGestureRecognizer = std::move(m_pendingTouchpadGestureRecognizer);
+        m_pendingTouchpadGestureRecognizer = nullptr;
+        m_latencyMonitor.setGestureRecognizer(m_touchpadGestureRecognizer);
+    }
+}
+
+bool GestureInputEventFilter::setInputTrace(const QString &path)
+{
+    if (path.isEmpty()) {
+        m_traceRecorder = nullptr;
+        return true;
+    }
+    if (m_traceRecorder && m_traceRecorder->path() == path) {
+        return true;
+    }
+
+    m_traceRecorder = std::make_unique<libgestures::TraceRecorder>(path);
+    if (!m_traceRecorder->isOpen()) {
+        m_traceRecorder = nullptr;
+        return false;
+    }
+    return true;
+}
+
+void GestureInputEventFilter::recordEvent(const libgestures::TraceEventType &type, const std::chrono::microseconds &time,
+                                          const uint8_t &fingers, const QPointF &delta, const qreal &scale, const qreal &angleDelta)
 {
-    Q_UNUSED(time)
+    if (!m_traceRecorder) {
+        return;
+    }
 
+    m_traceRecorder->record({
+        .time = static_cast<uint64_t>(time.count()),
+        .deltaX = static_cast<float>(delta.x()),
+        .deltaY = static_cast<float>(delta.y()),
+        .scale = static_cast<float>(scale),
+        .angleDelta = static_cast<float>(angleDelta),
+        .type = type,
+        .fingers = fingers,
+    });
+}
+
+bool GestureInputEventFilter::holdGestureBegin(int fingerCount, std::chrono::microseconds time)
+{
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
-    m_touchpadGestureRecognizer->holdGestureBegin(fingerCount);
-    m_touchpadHoldGestureTimer.start(s_holdDelta);
+    applyPendingTouchpadGestureRecognizer();
+    m_latencyMonitor.gestureBegin(time);
+    recordEvent(libgestures::TraceEventType::HoldBegin, time, fingerCount);
+    // Hold gestures are timed with the scheduler's clock
+    m_touchpadGestureRecognizer->holdGestureBegin(fingerCount, timestamp());
+    scheduleHoldGestureUpdate();
     return false;
 }
 
-void GestureInputEventFilter::holdGestureUpdate(const qreal &delta)
+void GestureInputEventFilter::holdGestureUpdate()
 {
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return;
 #endif
 
+    // Hold gestures are updated by the scheduler rather than input events
+    const auto time = timestamp();
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::HoldUpdate, time);
+    // Input sent by actions of all gestures is processed once
+    const libgestures::InputBatch batch;
     auto endedPrematurely = false;
-    m_touchpadGestureRecognizer->holdGestureUpdate(delta, endedPrematurely);
-    if (!endedPrematurely)
+    m_touchpadGestureRecognizer->holdGestureUpdate(time, endedPrematurely);
+    if (endedPrematurely) {
+        holdGestureEnd(timestamp());
         return;
+    }
 
-    holdGestureEnd(timestamp());
+    scheduleHoldGestureUpdate();
 }
 
-bool GestureInputEventFilter::holdGestureEnd(std::chrono::microseconds time)
+void GestureInputEventFilter::scheduleHoldGestureUpdate()
 {
-    Q_UNUSED(time)
+    if (const auto nextUpdate = m_touchpadGestureRecognizer->holdGestureNextUpdate()) {
+        m_scheduler.schedule(m_touchpadHoldGestureUpdateTask, *nextUpdate);
+    } else {
+        m_scheduler.cancel(m_touchpadHoldGestureUpdateTask);
+    }
+}
 
-    m_touchpadHoldGestureTimer.stop();
+bool GestureInputEventFilter::holdGestureEnd(std::chrono::microseconds time)
+{
+    m_scheduler.cancel(m_touchpadHoldGestureUpdateTask);
 
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
-    if (m_touchpadGestureRecognizer->holdGestureEnd()) {
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::HoldEnd, time);
+    const libgestures::InputBatch batch;
+    if (m_touchpadGestureRecognizer->holdGestureEnd(timestamp())) {
         KWin::input()->processSpies([&time](auto &&spy) {
             spy->holdGestureCancelled(time);
         });
@@ -88,43 +157,46 @@ bool GestureInputEventFilter::holdGestureEnd(std::chrono::microseconds time)
 
 bool GestureInputEventFilter::holdGestureCancelled(std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
-    m_touchpadHoldGestureTimer.stop();
+    m_scheduler.cancel(m_touchpadHoldGestureUpdateTask);
 
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
-    m_touchpadGestureRecognizer->holdGestureCancel();
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::HoldCancel, time);
+    const libgestures::InputBatch batch;
+    m_touchpadGestureRecognizer->holdGestureCancel(timestamp());
     return false;
 }
 
 bool GestureInputEventFilter::swipeGestureBegin(int fingerCount, std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
-    m_touchpadGestureRecognizer->swipeGestureBegin(fingerCount);
+    applyPendingTouchpadGestureRecognizer();
+    m_latencyMonitor.gestureBegin(time);
+    recordEvent(libgestures::TraceEventType::SwipeBegin, time, fingerCount);
+    m_touchpadGestureRecognizer->swipeGestureBegin(fingerCount, time);
     return false;
 }
 
 bool GestureInputEventFilter::swipeGestureUpdate(const QPointF &delta, std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::SwipeUpdate, time, 0, delta);
+    const libgestures::InputBatch batch;
     auto endedPrematurely = false;
-    const auto filter = m_touchpadGestureRecognizer->swipeGestureUpdate(delta, endedPrematurely);
+    const auto filter = m_touchpadGestureRecognizer->swipeGestureUpdate(delta, time, endedPrematurely);
     if (endedPrematurely) {
         swipeGestureEnd(time);
         return true;
@@ -135,13 +207,14 @@ bool GestureInputEventFilter::swipeGestureUpdate(const QPointF &delta, std::chro
 
 bool GestureInputEventFilter::swipeGestureEnd(std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::SwipeEnd, time);
+    const libgestures::InputBatch batch;
     if (m_touchpadGestureRecognizer->swipeGestureEnd()) {
         KWin::input()->processSpies([&time](auto &&spy) {
             spy->swipeGestureCancelled(time);
@@ -157,35 +230,35 @@ bool GestureInputEventFilter::swipeGestureEnd(std::chrono::microseconds time)
 
 bool GestureInputEventFilter::swipeGestureCancelled(std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::SwipeCancel, time);
+    const libgestures::InputBatch batch;
     m_touchpadGestureRecognizer->swipeGestureCancel();
     return false;
 }
 
 bool GestureInputEventFilter::pinchGestureBegin(int fingerCount, std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
     m_pinchGestureActive = true;
-    m_touchpadGestureRecognizer->pinchGestureBegin(fingerCount);
+    applyPendingTouchpadGestureRecognizer();
+    m_latencyMonitor.gestureBegin(time);
+    recordEvent(libgestures::TraceEventType::PinchBegin, time, fingerCount);
+    m_touchpadGestureRecognizer->pinchGestureBegin(fingerCount, time);
     return false;
 }
 
 bool GestureInputEventFilter::pinchGestureUpdate(qreal scale, qreal angleDelta, const QPointF &delta, std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
@@ -197,8 +270,11 @@ bool GestureInputEventFilter::pinchGestureUpdate(qreal scale, qreal angleDelta,
         pinchGestureBegin(2, time);
     }
 
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::PinchUpdate, time, 0, delta, scale, angleDelta);
+    const libgestures::InputBatch batch;
     auto endedPrematurely = false;
-    const auto filter = m_touchpadGestureRecognizer->pinchGestureUpdate(scale, angleDelta, delta, endedPrematurely);
+    const auto filter = m_touchpadGestureRecognizer->pinchGestureUpdate(scale, angleDelta, delta, time, endedPrematurely);
     if (endedPrematurely) {
         pinchGestureEnd(time);
         return true;
@@ -209,14 +285,15 @@ bool GestureInputEventFilter::pinchGestureUpdate(qreal scale, qreal angleDelta,
 
 bool GestureInputEventFilter::pinchGestureEnd(std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
     m_pinchGestureActive = false;
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::PinchEnd, time);
+    const libgestures::InputBatch batch;
     if (m_touchpadGestureRecognizer->pinchGestureEnd()) {
         KWin::input()->processSpies([&time](auto &&spy) {
             spy->pinchGestureCancelled(time);
@@ -232,14 +309,15 @@ bool GestureInputEventFilter::pinchGestureEnd(std::chrono::microseconds time)
 
 bool GestureInputEventFilter::pinchGestureCancelled(std::chrono::microseconds time)
 {
-    Q_UNUSED(time)
-
 #ifndef KWIN_6_2_OR_GREATER
     if (KWin::waylandServer()->isScreenLocked())
         return false;
 #endif
 
     m_pinchGestureActive = false;
+    m_latencyMonitor.event(time);
+    recordEvent(libgestures::TraceEventType::PinchCancel, time);
+    const libgestures::InputBatch batch;
     m_touchpadGestureRecognizer->pinchGestureCancel();
     return false;
 }
@@ -251,6 +329,7 @@ bool GestureInputEventFilter::pointerAxis(KWin::PointerAxisEvent *event)
     const auto eventDelta = event->delta;
     const auto orientation = event->orientation;
     const auto inverted = event->inverted;
+    const auto time = event->timestamp;
 #else
 bool GestureInputEventFilter::wheelEvent(KWin::WheelEvent *event)
 {
@@ -258,17 +337,24 @@ bool GestureInputEventFilter::wheelEvent(KWin::WheelEvent *event)
     const auto eventDelta = event->delta();
     const auto orientation = event->orientation();
     const auto inverted = event->inverted();
+    // QInputEvent only stores milliseconds
+    const std::chrono::microseconds time = std::chrono::milliseconds(event->timestamp());
 #endif
 
     if (!device->isTouchpad()) {
         return false;
     }
 
-    if (!m_scrollTimer.isActive()) {
-        swipeGestureBegin(2, timestamp());
+    if (!m_scheduler.isScheduled(m_scrollEndTask)) {
+        // Scrolling is the most frequent touchpad input, so don't do anything if it can't trigger a gesture. The
+        // pending recognizer is the one the gesture would begin in.
+        const auto &gestureRecognizer = m_pendingTouchpadGestureRecognizer ? m_pendingTouchpadGestureRecognizer : m_touchpadGestureRecognizer;
+        if (!gestureRecognizer->hasGestures(libgestures::GestureType::Swipe, 2)) {
+            return false;
+        }
+        swipeGestureBegin(2, time);
     }
-    m_scrollTimer.stop();
-    m_scrollTimer.start(s_scrollTimeout);
+    m_scheduler.schedule(m_scrollEndTask, time + std::chrono::milliseconds(m_touchpadGestureRecognizer->scrollTimeout()));
 
     auto delta = orientation == Qt::Orientation::Horizontal
         ? QPointF(eventDelta, 0)
@@ -276,7 +362,7 @@ bool GestureInputEventFilter::wheelEvent(KWin::WheelEvent *event)
     if (inverted) {
         delta *= -1;
     }
-    if (swipeGestureUpdate(delta, timestamp())) {
+    if (swipeGestureUpdate(delta, time)) {
         return true;
     }
 
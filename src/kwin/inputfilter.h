@@ -1,8 +1,10 @@
 #pragma once
 
+#include "impl/timerfdscheduler.h"
 #include "input.h"
+#include "latencymonitor.h"
 #include "libgestures/gestures/gesturerecognizer.h"
-#include <QTimer>
+#include "libgestures/trace.h"
 
 /**
  * Installed before GlobalShortcutFilter. Prevents it from receiving input events for which a custom gesture added by
@@ -21,10 +23,29 @@ class GestureInputEventFilter : public QObject, public KWin::InputEventFilter
 public:
     GestureInputEventFilter();
 
+    /**
+     * The recognizer is replaced when the next gesture begins while no gesture of any type is active, so that gestures
+     * in progress are handled by the recognizer they began in.
+     */
     void setTouchpadGestureRecognizer(const std::shared_ptr<libgestures::GestureRecognizer> &gestureRecognizer);
 
+    /**
+     * Starts recording events passed to the gesture recognizer to the specified file, or stops recording if the path
+     * is empty. Recording continues without truncating the file if the path hasn't changed.
+     * @return Whether the file could be opened.
+     */
+    bool setInputTrace(const QString &path);
+
+    /**
+     * @return Whether any gesture is active on the current touchpad gesture recognizer.
+     */
+    bool hasActiveGestures() const;
+
     bool holdGestureBegin(int fingerCount, std::chrono::microseconds time) override;
-    void holdGestureUpdate(const qreal &delta);
+    /**
+     * Updates hold gestures with the time elapsed since the last update.
+     */
+    void holdGestureUpdate();
     bool holdGestureEnd(std::chrono::microseconds time) override;
     bool holdGestureCancelled(std::chrono::microseconds time) override;
 
@@ -45,9 +66,39 @@ public:
 #endif
 
 private:
+    /**
+     * Replaces the recognizer with the one passed to setTouchpadGestureRecognizer, if any and if no gesture is active on
+     * the current one. Called when a gesture begins.
+     */
+    void applyPendingTouchpadGestureRecognizer();
+
+    /**
+     * Schedules the next hold gesture update for the time requested by the recognizer, or cancels it if no further
+     * update can have any effect.
+     */
+    void scheduleHoldGestureUpdate();
+
+    /**
+     * Adds the event to the input trace, if one is being recorded.
+     */
+    void recordEvent(const libgestures::TraceEventType &type, const std::chrono::microseconds &time, const uint8_t &fingers = 0,
+                     const QPointF &delta = QPointF(), const qreal &scale = 1, const qreal &angleDelta = 0);
+
     std::shared_ptr<libgestures::GestureRecognizer> m_touchpadGestureRecognizer = std::make_shared<libgestures::GestureRecognizer>();
-    QTimer m_touchpadHoldGestureTimer;
-    QTimer m_scrollTimer;
+    std::shared_ptr<libgestures::GestureRecognizer> m_pendingTouchpadGestureRecognizer;
+    /**
+     * Owns all deadline-based work of the filter.
+     */
+    TimerFdScheduler m_scheduler;
+    libgestures::Scheduler::TaskId m_touchpadHoldGestureUpdateTask;
+    /**
+     * Scheduled while a scroll gesture is active, moved by every scroll event. The scheduler re-arms its timer lazily,
+     * so this doesn't cause any syscalls.
+     */
+    libgestures::Scheduler::TaskId m_scrollEndTask;
 
     bool m_pinchGestureActive = false;
+
+    LatencyMonitor m_latencyMonitor;
+    std::unique_ptr<libgestures::TraceRecorder> m_traceRecorder;
 };
\ No newline at end of file
@@ -0,0 +1,149 @@
+#include "latencymonitor.h"
+
+#include "utils.h"
+
+#include "libgestures/actions/plasmaglobalshortcut.h"
+#include "libgestures/commandexecutor.h"
+
+#include <QDBusConnection>
+
+static const QString s_dbusPath = QStringLiteral("/KWinGestures");
+
+static QString gestureTypeName(const libgestures::GestureType &type)
+{
+    switch (type) {
+    case libgestures::GestureType::Hold:
+        return QStringLiteral("hold");
+    case libgestures::GestureType::Pinch:
+        return QStringLiteral("pinch");
+    case libgestures::GestureType::Rotate:
+        return QStringLiteral("rotate");
+    case libgestures::GestureType::Swipe:
+        return QStringLiteral("swipe");
+    }
+    Q_UNREACHABLE();
+}
+
+static QString histogramSummary(const QString &name, const libgestures::LatencyHistogram &histogram)
+{
+    return QStringLiteral("%1: count=%2 p50=%3 p99=%4 max=%5")
+        .arg(name)
+        .arg(static_cast<qulonglong>(histogram.count()))
+        .arg(static_cast<qlonglong>(histogram.percentile(50).count()))
+        .arg(static_cast<qlonglong>(histogram.percentile(99).count()))
+        .arg(static_cast<qlonglong>(histogram.maximum().count()));
+}
+
+LatencyMonitor::LatencyMonitor()
+{
+    QDBusConnection::sessionBus().registerObject(s_dbusPath, this, QDBusConnection::ExportScriptableSlots);
+}
+
+LatencyMonitor::~LatencyMonitor()
+{
+    QDBusConnection::sessionBus().unregisterObject(s_dbusPath);
+}
+
+void LatencyMonitor::setGestureRecognizer(const std::shared_ptr<libgestures::GestureRecognizer> &gestureRecognizer)
+{
+    for (const auto &connection : m_connections) {
+        disconnect(connection);
+    }
+    m_connections.clear();
+    m_latencies.clear();
+    m_gestureRecognizer = gestureRecognizer;
+
+    for (const auto &gesture : gestureRecognizer->gestures()) {
+        auto &latency = *m_latencies.emplace_back(std::make_unique<GestureLatency>());
+        m_connections.push_back(connect(gesture.get(), &libgestures::Gesture::started, this, [this, &latency]() {
+            gestureStarted(latency);
+        }));
+        for (const auto &action : gesture->actions()) {
+            m_connections.push_back(connect(action.get(), &libgestures::GestureAction::executed, this, [this, &latency]() {
+                actionExecuted(latency);
+            }));
+        }
+    }
+}
+
+void LatencyMonitor::gestureBegin(const std::chrono::microseconds &time)
+{
+    m_gestureBegins++;
+    m_gestureBeginTime = time;
+    m_eventTime = time;
+}
+
+void LatencyMonitor::event(const std::chrono::microseconds &time)
+{
+    m_eventTime = time;
+}
+
+void LatencyMonitor::gestureStarted(GestureLatency &latency)
+{
+    synchronize(latency);
+    const auto now = timestamp();
+    latency.beginToStarted.record(now - m_gestureBeginTime);
+    latency.started = now;
+}
+
+void LatencyMonitor::actionExecuted(GestureLatency &latency)
+{
+    synchronize(latency);
+    const auto now = timestamp();
+    latency.eventToActionExecuted.record(now - m_eventTime);
+    if (!latency.actionExecuted) {
+        latency.actionExecuted = true;
+        // Actions executed on begin run before the started signal is emitted
+        latency.startedToFirstAction.record(latency.started ? now - *latency.started : std::chrono::microseconds(0));
+    }
+}
+
+void LatencyMonitor::synchronize(GestureLatency &latency) const
+{
+    if (latency.gestureBegin != m_gestureBegins) {
+        latency.gestureBegin = m_gestureBegins;
+        latency.started = std::nullopt;
+        latency.actionExecuted = false;
+    }
+}
+
+QString LatencyMonitor::summary() const
+{
+    QStringList lines;
+    for (size_t i = 0; i < m_latencies.size(); i++) {
+        const auto &gesture = m_gestureRecognizer->gestures()[i];
+        const auto &latency = *m_latencies[i];
+        lines << QStringLiteral("%1 (%2, %3-%4 fingers): %5; %6; %7")
+                     .arg(static_cast<qulonglong>(i))
+                     .arg(gestureTypeName(gesture->type()))
+                     .arg(static_cast<int>(gesture->minimumFingers()))
+                     .arg(static_cast<int>(gesture->maximumFingers()))
+                     .arg(histogramSummary(QStringLiteral("begin to started"), latency.beginToStarted),
+                          histogramSummary(QStringLiteral("started to first action"), latency.startedToFirstAction),
+                          histogramSummary(QStringLiteral("event to action executed"), latency.eventToActionExecuted));
+    }
+    lines << histogramSummary(QStringLiteral("global shortcut round trip"), libgestures::PlasmaGlobalShortcutGestureAction::latency());
+    return lines.join('\n');
+}
+
+QString LatencyMonitor::commandSummary() const
+{
+    const auto executor = libgestures::CommandExecutor::instance();
+    return QStringLiteral("completed=%1 failed=%2 dropped=%3 queued=%4")
+        .arg(static_cast<qulonglong>(executor->completed()))
+        .arg(static_cast<qulonglong>(executor->failed()))
+        .arg(static_cast<qulonglong>(executor->dropped()))
+        .arg(executor->queued());
+}
+
+void LatencyMonitor::reset()
+{
+    for (const auto &latency : m_latencies) {
+        latency->beginToStarted.reset();
+        latency->startedToFirstAction.reset();
+        latency->eventToActionExecuted.reset();
+    }
+    libgestures::PlasmaGlobalShortcutGestureAction::latency().reset();
+}
+
+#include "moc_latencymonitor.cpp"
@@ -0,0 +1,95 @@
+#pragma once
+
+#include "libgestures/gestures/gesturerecognizer.h"
+#include "libgestures/latencyhistogram.h"
+
+#include <QObject>
+
+#include <chrono>
+
+/**
+ * Measures how long it takes for gestures to start and for their actions to execute. Published on D-Bus as
+ * /KWinGestures (org.kde.kwin_gestures.Latency).
+ *
+ * Latencies are measured from the timestamps of input events, which use the monotonic clock.
+ */
+class LatencyMonitor : public QObject
+{
+    Q_OBJECT
+    Q_CLASSINFO("D-Bus Interface", "org.kde.kwin_gestures.Latency")
+public:
+    LatencyMonitor();
+    ~LatencyMonitor() override;
+
+    /**
+     * Starts measuring the gestures of the specified recognizer. Latencies recorded for the previous recognizer are
+     * discarded.
+     */
+    void setGestureRecognizer(const std::shared_ptr<libgestures::GestureRecognizer> &gestureRecognizer);
+
+    /**
+     * Must be called before the gesture recognizer processes a begin event.
+     */
+    void gestureBegin(const std::chrono::microseconds &time);
+    /**
+     * Must be called before the gesture recognizer processes any event.
+     */
+    void event(const std::chrono::microseconds &time);
+
+public slots:
+    /**
+     * @return One line per gesture, in the order the gestures are defined in the configuration, containing the count,
+     * 50th and 99th percentile and maximum of every latency in microseconds, followed by a line with the round trip
+     * latency of global shortcut invocations.
+     */
+    Q_SCRIPTABLE QString summary() const;
+    /**
+     * @return The amount of command executions that have completed, failed, been dropped or merged, and that are
+     * currently queued. Counted since the plugin was loaded.
+     */
+    Q_SCRIPTABLE QString commandSummary() const;
+    Q_SCRIPTABLE void reset();
+
+private:
+    struct GestureLatency
+    {
+        /**
+         * From the begin event to the gesture's threshold being reached.
+         */
+        libgestures::LatencyHistogram beginToStarted;
+        /**
+         * From the gesture's threshold being reached to the first action being executed.
+         */
+        libgestures::LatencyHistogram startedToFirstAction;
+        /**
+         * From the input event that was being processed to an action being executed.
+         */
+        libgestures::LatencyHistogram eventToActionExecuted;
+
+        /**
+         * The begin event the fields below belong to, see m_gestureBegins.
+         */
+        uint64_t gestureBegin = 0;
+        std::optional<std::chrono::microseconds> started;
+        bool actionExecuted = false;
+    };
+
+    void gestureStarted(GestureLatency &latency);
+    void actionExecuted(GestureLatency &latency);
+
+    /**
+     * Resets the state of the current gesture if it belongs to a previous begin event.
+     */
+    void synchronize(GestureLatency &latency) const;
+
+    std::shared_ptr<libgestures::GestureRecognizer> m_gestureRecognizer;
+    /**
+     * Indexed the same as the recognizer's gestures.
+     */
+    std::vector<std::unique_ptr<GestureLatency>> m_latencies;
+    std::vector<QMetaObject::Connection> m_connections;
+
+    uint64_t m_gestureBegins = 0;
+    std::chrono::microseconds m_gestureBeginTime{};
+    std::chrono::microseconds m_eventTime{};
+};
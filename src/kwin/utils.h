@@ -1,8 +1,13 @@
 #pragma once
 
+#include "libgestures/clock.h"
+
 #include <chrono>
 
+/**
+ * @return The current time on the monotonic clock, which is also used for timestamps of input events.
+ */
 inline std::chrono::microseconds timestamp()
 {
-    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now().time_since_epoch());
+    return libgestures::Clock::implementation()->now();
 }
\ No newline at end of file
@@ -1,15 +1,10 @@
 #include "action.h"
 
-namespace libgestures
-{
+#include <cmath>
+#include <limits>
 
-GestureAction::GestureAction()
+namespace libgestures
 {
-    connect(this, &GestureAction::gestureCancelled, this, &GestureAction::onGestureCancelled);
-    connect(this, &GestureAction::gestureEnded, this, &GestureAction::onGestureEnded);
-    connect(this, &GestureAction::gestureStarted, this, &GestureAction::onGestureStarted);
-    connect(this, &GestureAction::gestureUpdated, this, &GestureAction::onGestureUpdated);
-}
 
 void GestureAction::addCondition(const std::shared_ptr<const Condition> &condition)
 {
@@ -29,8 +24,10 @@ bool GestureAction::thresholdReached() const
         && (m_maximumThreshold == 0 || m_absoluteAccumulatedDelta <= m_maximumThreshold);
 }
 
-bool GestureAction::tryExecute()
+bool GestureAction::tryExecute(const uint32_t &count)
 {
+    Q_UNUSED(count)
+
     if (!satisfiesConditions() || !thresholdReached()) {
         return false;
     }
@@ -40,6 +37,23 @@ bool GestureAction::tryExecute()
     return true;
 }
 
+std::optional<qreal> GestureAction::remainingDelta() const
+{
+    if (m_on != On::Update || m_repeatInterval < 0
+        || (m_maximumThreshold != 0 && m_absoluteAccumulatedDelta > m_maximumThreshold)) {
+        return std::nullopt;
+    }
+
+    qreal remaining = 0;
+    if (m_minimumThreshold != 0) {
+        remaining = std::max(m_minimumThreshold - m_absoluteAccumulatedDelta, remaining);
+    }
+    if (m_repeatInterval > 0) {
+        remaining = std::max(m_repeatInterval - m_accumulatedDelta, remaining);
+    }
+    return remaining;
+}
+
 bool GestureAction::blocksOtherActions() const
 {
     return m_executed && m_blockOtherActions;
@@ -53,6 +67,8 @@ void GestureAction::onGestureCancelled()
 
     m_accumulatedDelta = 0;
     m_absoluteAccumulatedDelta = 0;
+
+    Q_EMIT gestureCancelled();
 }
 
 void GestureAction::onGestureEnded()
@@ -63,6 +79,8 @@ void GestureAction::onGestureEnded()
 
     m_accumulatedDelta = 0;
     m_absoluteAccumulatedDelta = 0;
+
+    Q_EMIT gestureEnded();
 }
 
 void GestureAction::onGestureStarted()
@@ -74,6 +92,8 @@ void GestureAction::onGestureStarted()
 
     m_accumulatedDelta = 0;
     m_absoluteAccumulatedDelta = 0;
+
+    Q_EMIT gestureStarted();
 }
 
 void GestureAction::onGestureUpdated(const qreal &delta, const QPointF &deltaPointMultiplied)
@@ -87,20 +107,29 @@ void GestureAction::onGestureUpdated(const qreal &delta, const QPointF &deltaPoi
         m_absoluteAccumulatedDelta += std::abs(delta);
     }
 
-    if (m_on != On::Update) {
-        return;
+    if (m_on == On::Update) {
+        executeRepeated();
     }
+
+    Q_EMIT gestureUpdated(delta, deltaPointMultiplied);
+}
+
+void GestureAction::executeRepeated()
+{
     if (m_repeatInterval == 0) {
         tryExecute();
         return;
     }
 
-    // Keep executing action until accumulated delta no longer exceeds the interval
-    while (((m_accumulatedDelta > 0 && m_repeatInterval > 0) || (m_accumulatedDelta < 0 && m_repeatInterval < 0))
-           && std::abs(m_accumulatedDelta / m_repeatInterval) >= 1) {
-        tryExecute();
-        m_accumulatedDelta -= m_repeatInterval;
+    // Execute the action once for every interval the accumulated delta exceeds, but only check conditions and
+    // synthesize input once
+    const auto intervals = m_accumulatedDelta / m_repeatInterval;
+    if (intervals < 1) {
+        return;
     }
+    const auto count = static_cast<uint32_t>(std::min<qreal>(std::floor(intervals), std::numeric_limits<uint32_t>::max()));
+    tryExecute(count);
+    m_accumulatedDelta -= count * m_repeatInterval;
 }
 
 void GestureAction::setBlockOtherActions(const bool &blockOtherActions)
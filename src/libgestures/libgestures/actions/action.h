@@ -48,15 +48,24 @@ class GestureAction : public QObject
 public:
     /**
      * Executes the action if conditions are satisfied and the threshold reached. Does nothing otherwise.
+     * @param count How many times to execute the action. Conditions are only checked once and executed is only emitted
+     * once, no matter the count.
      * @return Whether the action has been executed.
      */
-    virtual bool tryExecute();
+    virtual bool tryExecute(const uint32_t &count = 1);
 
     /**
      * @return Whether the action satisfies at least one condition, or no conditions have been added.
      */
     bool satisfiesConditions() const;
 
+    /**
+     * @return How much more delta needs to be accumulated before an update can cause this action to be executed, 0 if
+     * any update can, or std::nullopt if no update ever will.
+     * @remark Assumes that all future deltas are positive, which is only guaranteed for hold gestures.
+     */
+    std::optional<qreal> remainingDelta() const;
+
     /**
      * @return Whether this action should block all other actions, including actions belonging to other custom and
      * built-in gestures, from being executed during the gesture, if the action is executed.
@@ -77,8 +86,8 @@ public:
     /**
      * @param interval How often an update action should repeat.
      * If 0, the action will be executed exactly once per input event.
-     * If not 0, the action will only be executed when the accumulated delta reaches this interval, and will keep
-     * being executed until the delta is smaller than the interval.
+     * If not 0, the action will only be executed when the accumulated delta reaches this interval, once for every
+     * time the interval fits into the delta. All executions caused by a single update are performed as one batch.
      */
     void setRepeatInterval(const qreal &interval);
 
@@ -93,9 +102,33 @@ public:
      * @param on The point during the gesture at which the action should be executed.
      */
     void setOn(const On &on);
+
+    /**
+     * Called by the gesture this action belongs to when it has been cancelled.
+     */
+    void onGestureCancelled();
+
+    /**
+     * Called by the gesture this action belongs to when it has ended.
+     */
+    void onGestureEnded();
+
+    /**
+     * Called by the gesture this action belongs to when it has began and its threshold has been reached.
+     */
+    void onGestureStarted();
+
+    /**
+     * Called by the gesture this action belongs to when it has been updated.
+     */
+    void onGestureUpdated(const qreal &delta, const QPointF &deltaPointMultiplied);
 signals:
+    // Only emitted for observers, the gesture calls the onGesture* methods directly. The signals are emitted after the
+    // action has handled the event, so observers see the effects of the action, same as when the signals were
+    // connected to the onGesture* methods.
+
     /**
-     * Emitted when the action has been executed.
+     * Emitted when the action has been executed, once per batch of executions.
      */
     void executed();
 
@@ -116,20 +149,16 @@ signals:
     void gestureStarted();
 
     /**
-     * Emitted when the gesture this action belongs to has been updated.
+     * Emitted when the gesture this action belongs to has been updated. Only emitted once the gesture's threshold has
+     * been reached.
      */
     void gestureUpdated(const qreal &delta, const QPointF &deltaPointMultiplied);
 
 protected:
-    GestureAction();
+    GestureAction() = default;
 
     // This is just a quick way to get directionless swipe gestures working
     QPointF m_currentDeltaPointMultiplied;
-private slots:
-    void onGestureCancelled();
-    void onGestureEnded();
-    void onGestureStarted();
-    void onGestureUpdated(const qreal &delta, const QPointF &deltaPointMultiplied);
 
 private:
     /**
@@ -137,6 +166,11 @@ private:
      */
     bool thresholdReached() const;
 
+    /**
+     * Executes the update action as many times as the repeat interval allows.
+     */
+    void executeRepeated();
+
     std::vector<std::shared_ptr<const Condition>> m_conditions;
 
     /**
@@ -161,6 +195,7 @@ private:
     qreal m_maximumThreshold = 0;
     On m_on = On::Update;
 
+    friend class ConfigCache;
     friend class TestGestureRecognizer;
 };
 
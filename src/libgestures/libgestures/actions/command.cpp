@@ -1,26 +1,29 @@
 #include "command.h"
 
-#include <thread>
-
 namespace libgestures
 {
 
-bool CommandGestureAction::tryExecute()
+bool CommandGestureAction::tryExecute(const uint32_t &count)
 {
-    if (!GestureAction::tryExecute()) {
+    if (!GestureAction::tryExecute(count)) {
         return false;
     }
 
-    std::thread thread([this]() {
-        std::system(m_command.c_str());
-    });
-    thread.detach();
+    const auto executions = m_coalescing == CommandCoalescing::None ? count : 1;
+    // The executor stops accepting executions once its queue is full
+    for (uint32_t i = 0; i < executions && CommandExecutor::instance()->execute(m_command, m_coalescing); i++) {
+    }
     return true;
 }
 
 void CommandGestureAction::setCommand(const QString &command)
 {
-    m_command = command.toStdString();
+    m_command = std::make_shared<Command>(command);
+}
+
+void CommandGestureAction::setCoalescing(const CommandCoalescing &coalescing)
+{
+    m_coalescing = coalescing;
 }
 
-}
\ No newline at end of file
+}
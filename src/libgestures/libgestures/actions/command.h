@@ -1,6 +1,7 @@
 #pragma once
 
 #include "action.h"
+#include "libgestures/commandexecutor.h"
 
 #include <QString>
 
@@ -8,16 +9,28 @@ namespace libgestures
 {
 
 /**
- * Runs a command.
+ * Runs a command using CommandExecutor.
  */
 class CommandGestureAction : public GestureAction
 {
 public:
-    bool tryExecute() override;
+    /**
+     * Queues the command the specified amount of times if coalescing is None, otherwise only once, since further
+     * executions would be dropped or merged anyway.
+     */
+    bool tryExecute(const uint32_t &count = 1) override;
     void setCommand(const QString &command);
 
+    /**
+     * @param coalescing How executions are handled when the previous one hasn't finished yet.
+     */
+    void setCoalescing(const CommandCoalescing &coalescing);
+
 private:
-    std::string m_command;
+    std::shared_ptr<Command> m_command;
+    CommandCoalescing m_coalescing = CommandCoalescing::None;
+
+    friend class ConfigCache;
 };
 
-}
\ No newline at end of file
+}
@@ -1,38 +1,43 @@
 #include "libgestures/libgestures/actions/input.h"
 
+#include <algorithm>
+
 namespace libgestures
 {
 
-bool InputGestureAction::tryExecute()
+bool InputGestureAction::tryExecute(const uint32_t &count)
 {
-    if (!GestureAction::tryExecute()) {
+    if (!GestureAction::tryExecute(count)) {
         return false;
     }
 
     const auto input = libgestures::Input::implementation();
-    for (const auto &action : m_sequence) {
-        for (const auto &key : action.keyboardPress) {
-            input->keyboardKey(key, true);
-        }
-        for (const auto &key : action.keyboardRelease) {
-            input->keyboardKey(key, false);
-        }
-
-        for (const auto &button : action.mousePress) {
-            input->mouseButton(button, true);
-        }
-        for (const auto &button : action.mouseRelease) {
-            input->mouseButton(button, false);
-        }
-
-        if (!action.mouseMoveAbsolute.isNull()) {
-            input->mouseMoveAbsolute(action.mouseMoveAbsolute);
-        }
-        if (!action.mouseMoveRelative.isNull()) {
-            input->mouseMoveRelative(action.mouseMoveRelative);
-        }
-        if (action.mouseMoveRelativeByDelta) {
-            input->mouseMoveRelative(m_currentDeltaPointMultiplied);
+    const InputBatch batch;
+    for (uint32_t i = 0; i < std::min(count, s_maxRepeats); i++) {
+        for (const auto &action : m_sequence) {
+            for (const auto &key : action.keyboardPress) {
+                input->keyboardKey(key, true);
+            }
+            for (const auto &key : action.keyboardRelease) {
+                input->keyboardKey(key, false);
+            }
+
+            for (const auto &button : action.mousePress) {
+                input->mouseButton(button, true);
+            }
+            for (const auto &button : action.mouseRelease) {
+                input->mouseButton(button, false);
+            }
+
+            if (!action.mouseMoveAbsolute.isNull()) {
+                input->mouseMoveAbsolute(action.mouseMoveAbsolute);
+            }
+            if (!action.mouseMoveRelative.isNull()) {
+                input->mouseMoveRelative(action.mouseMoveRelative);
+            }
+            if (action.mouseMoveRelativeByDelta) {
+                input->mouseMoveRelative(m_currentDeltaPointMultiplied);
+            }
         }
     }
 
@@ -1,3 +1,5 @@
+#pragma once
+
 #include "action.h"
 #include "libgestures/input.h"
 #include <QString>
@@ -24,7 +26,7 @@ struct InputAction
 };
 
 /**
- * Sends input.
+ * Sends input. The entire sequence is sent as a single batch.
  *
  * @remark Requires Input::keyboardKey, Input::mouseButton, Input::mouseMoveAbsolute and Input::mouseMoveRelative to be
  * implemented.
@@ -32,11 +34,23 @@ struct InputAction
 class InputGestureAction : public GestureAction
 {
 public:
-    bool tryExecute() override;
+    /**
+     * Sends the sequence the specified amount of times, up to s_maxRepeats, all in the same batch.
+     */
+    bool tryExecute(const uint32_t &count = 1) override;
     void setSequence(const std::vector<InputAction> &sequence);
 
 private:
     std::vector<InputAction> m_sequence;
+
+    /**
+     * Maximum amount of times the sequence is sent per batch, so that a single fast gesture can't flood the input
+     * stack.
+     */
+    static constexpr uint32_t s_maxRepeats = 64;
+
+    friend class ConfigCache;
+    friend class TestAction;
 };
 
 }
\ No newline at end of file
@@ -1,28 +1,58 @@
 #include "plasmaglobalshortcut.h"
-#include <QDBusInterface>
+
+#include <QDBusConnection>
+#include <QDBusPendingCallWatcher>
+
+#include <algorithm>
 
 namespace libgestures
 {
 
-bool PlasmaGlobalShortcutGestureAction::tryExecute()
+LatencyHistogram PlasmaGlobalShortcutGestureAction::s_latency;
+
+bool PlasmaGlobalShortcutGestureAction::tryExecute(const uint32_t &count)
 {
-    if (!GestureAction::tryExecute()) {
+    if (!GestureAction::tryExecute(count)) {
         return false;
     }
 
-    QDBusInterface interface("org.kde.kglobalaccel", m_path, "org.kde.kglobalaccel.Component");
-    interface.call("invokeShortcut", m_shortcut);
+    const auto start = std::chrono::steady_clock::now();
+    for (uint32_t i = 0; i < std::min(count, s_maxInvocations); i++) {
+        auto *watcher = new QDBusPendingCallWatcher(QDBusConnection::sessionBus().asyncCall(m_message), this);
+        // Later calls of the batch are queued behind the first one, so only its latency is meaningful
+        const auto recordLatency = i == 0;
+        connect(watcher, &QDBusPendingCallWatcher::finished, this, [start, recordLatency](QDBusPendingCallWatcher *watcher) {
+            if (recordLatency) {
+                s_latency.record(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start));
+            }
+            watcher->deleteLater();
+        });
+    }
     return true;
 }
 
 void PlasmaGlobalShortcutGestureAction::setComponent(const QString &component)
 {
+    m_component = component;
     m_path = "/component/" + component;
+    updateMessage();
 }
 
 void PlasmaGlobalShortcutGestureAction::setShortcut(const QString &shortcut)
 {
     m_shortcut = shortcut;
+    updateMessage();
 }
 
-}
\ No newline at end of file
+LatencyHistogram &PlasmaGlobalShortcutGestureAction::latency()
+{
+    return s_latency;
+}
+
+void PlasmaGlobalShortcutGestureAction::updateMessage()
+{
+    m_message = QDBusMessage::createMethodCall("org.kde.kglobalaccel", m_path, "org.kde.kglobalaccel.Component", "invokeShortcut");
+    m_message << m_shortcut;
+}
+
+}
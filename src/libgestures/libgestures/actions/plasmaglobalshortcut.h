@@ -1,24 +1,50 @@
 #pragma once
 
 #include "action.h"
+#include "libgestures/latencyhistogram.h"
+
+#include <QDBusMessage>
 #include <QString>
 
 namespace libgestures
 {
 
 /**
- * Invokes a Plasma global shortcut.
+ * Invokes a Plasma global shortcut. The call is made asynchronously and never blocks the caller.
  */
 class PlasmaGlobalShortcutGestureAction : public GestureAction
 {
 public:
-    bool tryExecute() override;
+    /**
+     * Invokes the shortcut the specified amount of times, up to s_maxInvocations.
+     */
+    bool tryExecute(const uint32_t &count = 1) override;
     void setComponent(const QString &component);
     void setShortcut(const QString &shortcut);
 
+    /**
+     * @return Round trip latency of the first D-Bus call of every execution of all actions of this type.
+     */
+    static LatencyHistogram &latency();
+
 private:
+    /**
+     * Rebuilds the message sent on execution. Called when the component or shortcut changes.
+     */
+    void updateMessage();
+
+    QString m_component;
     QString m_path;
     QString m_shortcut;
+    QDBusMessage m_message;
+
+    static LatencyHistogram s_latency;
+    /**
+     * Maximum amount of invocations per batch, so that a single fast gesture can't flood the session bus.
+     */
+    static constexpr uint32_t s_maxInvocations = 16;
+
+    friend class ConfigCache;
 };
 
-}
\ No newline at end of file
+}
@@ -0,0 +1,42 @@
+#include "clock.h"
+
+#include "scheduler.h"
+
+namespace libgestures
+{
+
+std::chrono::microseconds Clock::now() const
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now().time_since_epoch());
+}
+
+std::chrono::microseconds VirtualClock::now() const
+{
+    return m_time;
+}
+
+void VirtualClock::setTime(const std::chrono::microseconds &time)
+{
+    m_time = time;
+}
+
+void VirtualClock::advance(const std::chrono::microseconds &duration, Scheduler *scheduler)
+{
+    const auto end = m_time + duration;
+    if (scheduler) {
+        for (auto deadline = scheduler->nextDeadline(); deadline && *deadline <= end; deadline = scheduler->nextDeadline()) {
+            // Tasks may be scheduled for a time that has already passed
+            m_time = std::max(m_time, *deadline);
+            scheduler->run();
+        }
+    }
+    m_time = end;
+}
+
+std::unique_ptr<Clock> Clock::s_implementation = std::make_unique<Clock>();
+void Clock::setImplementation(Clock *implementation)
+{
+    s_implementation = std::unique_ptr<Clock>(implementation);
+}
+
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <chrono>
+#include <memory>
+
+namespace libgestures
+{
+
+class Scheduler;
+
+/**
+ * Provides the current time. All deadline-based work is measured against this clock.
+ *
+ * The default implementation uses the monotonic clock, which is also used for timestamps of input events.
+ */
+class Clock
+{
+public:
+    Clock() = default;
+    virtual ~Clock() = default;
+
+    virtual std::chrono::microseconds now() const;
+
+    static Clock *implementation()
+    {
+        return s_implementation.get();
+    }
+    static void setImplementation(Clock *implementation);
+
+private:
+    static std::unique_ptr<Clock> s_implementation;
+};
+
+/**
+ * Clock that only moves when told to, so that time-dependent behavior can be tested and benchmarked deterministically
+ * and without waiting.
+ */
+class VirtualClock : public Clock
+{
+public:
+    std::chrono::microseconds now() const override;
+    void setTime(const std::chrono::microseconds &time);
+
+    /**
+     * Moves the time forward.
+     * @param scheduler If not nullptr, tasks whose deadline is passed are run in the order of their deadlines, with the
+     * time set to the deadline, the same way they would run with a real clock.
+     */
+    void advance(const std::chrono::microseconds &duration, Scheduler *scheduler = nullptr);
+
+private:
+    std::chrono::microseconds m_time{};
+};
+
+}
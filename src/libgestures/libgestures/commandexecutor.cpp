@@ -0,0 +1,238 @@
+#include "commandexecutor.h"
+
+#include <QRegularExpression>
+
+#include <poll.h>
+#include <signal.h>
+#include <spawn.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+extern char **environ;
+
+namespace libgestures
+{
+
+static const QRegularExpression s_shellSyntax(R"([|&;<>()$`\\"'*?\[\]#~=%{}!\n])");
+static const QRegularExpression s_whitespace(QStringLiteral("\\s+"));
+
+Command::Command(const QString &command)
+    : m_command(command)
+{
+    if (command.contains(s_shellSyntax)) {
+        m_arguments = {"/bin/sh", "-c", command.toStdString()};
+    } else {
+        for (const auto &argument : command.split(s_whitespace, Qt::SkipEmptyParts)) {
+            m_arguments.push_back(argument.toStdString());
+        }
+    }
+
+    for (auto &argument : m_arguments) {
+        m_argv.push_back(argument.data());
+    }
+    m_argv.push_back(nullptr);
+}
+
+const QString &Command::command() const
+{
+    return m_command;
+}
+
+CommandExecutor::CommandExecutor()
+    : m_eventfd(eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK))
+{
+}
+
+CommandExecutor::~CommandExecutor()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+
+    if (m_thread.joinable()) {
+        wake();
+        m_thread.join();
+    }
+    close(m_eventfd);
+}
+
+bool CommandExecutor::execute(const std::shared_ptr<Command> &command, const CommandCoalescing &coalescing)
+{
+    if (command->m_argv.size() < 2) {
+        m_failed++;
+        return false;
+    }
+
+    {
+        std::lock_guard lock(m_mutex);
+        const auto drop = (coalescing == CommandCoalescing::Drop && (command->m_queued || command->m_running))
+            || (coalescing == CommandCoalescing::Merge && command->m_queued)
+            || m_queue.size() >= s_maxQueued;
+        if (drop) {
+            m_dropped++;
+            return false;
+        }
+
+        if (!m_thread.joinable()) {
+            m_thread = std::thread(&CommandExecutor::run, this);
+        }
+
+        command->m_queued++;
+        m_queue.push_back(command);
+    }
+
+    wake();
+    return true;
+}
+
+void CommandExecutor::setConcurrencyLimit(const uint32_t &limit)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_concurrencyLimit = limit;
+    }
+    wake();
+}
+
+uint64_t CommandExecutor::completed() const
+{
+    return m_completed;
+}
+
+uint64_t CommandExecutor::failed() const
+{
+    return m_failed;
+}
+
+uint64_t CommandExecutor::dropped() const
+{
+    return m_dropped;
+}
+
+uint32_t CommandExecutor::queued() const
+{
+    std::lock_guard lock(m_mutex);
+    return m_queue.size();
+}
+
+CommandExecutor *CommandExecutor::instance()
+{
+    static CommandExecutor executor;
+    return &executor;
+}
+
+void CommandExecutor::run()
+{
+    std::vector<Process> processes;
+    std::vector<std::shared_ptr<Command>> spawning;
+    std::vector<pollfd> fds;
+
+    posix_spawnattr_t attributes;
+    posix_spawnattr_init(&attributes);
+    sigset_t signalSet;
+    sigemptyset(&signalSet);
+    posix_spawnattr_setsigmask(&attributes, &signalSet);
+    sigfillset(&signalSet);
+    posix_spawnattr_setsigdefault(&attributes, &signalSet);
+    posix_spawnattr_setflags(&attributes, POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+
+    while (true) {
+        {
+            std::lock_guard lock(m_mutex);
+            if (m_stopping) {
+                break;
+            }
+
+            while (!m_queue.empty() && (!m_concurrencyLimit || processes.size() + spawning.size() < m_concurrencyLimit)) {
+                const auto command = m_queue.front();
+                m_queue.pop_front();
+                command->m_queued--;
+                command->m_running++;
+                spawning.push_back(command);
+            }
+        }
+
+        for (const auto &command : spawning) {
+            pid_t pid;
+            if (posix_spawnp(&pid, command->m_argv[0], nullptr, &attributes, command->m_argv.data(), environ) != 0) {
+                finished(command, false);
+                continue;
+            }
+
+            processes.push_back({command, pid, static_cast<int>(syscall(SYS_pidfd_open, pid, 0))});
+        }
+        spawning.clear();
+
+        fds.clear();
+        fds.push_back({m_eventfd, POLLIN, 0});
+        auto polling = false;
+        for (const auto &process : processes) {
+            fds.push_back({process.pidfd, POLLIN, 0});
+            polling |= process.pidfd == -1;
+        }
+        poll(fds.data(), fds.size(), polling ? 100 : -1);
+
+        if (fds[0].revents & POLLIN) {
+            eventfd_t value;
+            eventfd_read(m_eventfd, &value);
+        }
+
+        for (size_t i = 0; i < processes.size();) {
+            int status;
+            if ((processes[i].pidfd != -1 && !(fds[i + 1].revents & POLLIN))
+                || waitpid(processes[i].pid, &status, WNOHANG) != processes[i].pid) {
+                i++;
+                continue;
+            }
+
+            if (processes[i].pidfd != -1) {
+                close(processes[i].pidfd);
+            }
+            finished(processes[i].command, WIFEXITED(status) && WEXITSTATUS(status) == 0);
+            processes.erase(processes.begin() + i);
+            fds.erase(fds.begin() + i + 1);
+        }
+    }
+
+    posix_spawnattr_destroy(&attributes);
+
+    // Commands still running outlive the executor, reap them once they exit so that they don't become zombies
+    std::vector<pid_t> pids;
+    for (const auto &process : processes) {
+        if (process.pidfd != -1) {
+            close(process.pidfd);
+        }
+        pids.push_back(process.pid);
+    }
+    if (!pids.empty()) {
+        std::thread([pids = std::move(pids)]() {
+            for (const auto &pid : pids) {
+                waitpid(pid, nullptr, 0);
+            }
+        }).detach();
+    }
+}
+
+void CommandExecutor::finished(const std::shared_ptr<Command> &command, const bool &success)
+{
+    {
+        std::lock_guard lock(m_mutex);
+        command->m_running--;
+    }
+
+    if (success) {
+        m_completed++;
+    } else {
+        m_failed++;
+    }
+}
+
+void CommandExecutor::wake()
+{
+    eventfd_write(m_eventfd, 1);
+}
+
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace libgestures
+{
+
+/**
+ * How an execution of a command is handled when a previous execution of the same command hasn't finished yet.
+ */
+enum class CommandCoalescing {
+    /**
+     * Every execution is run. If a concurrency limit is set, executions over it wait in a queue.
+     */
+    None,
+
+    /**
+     * The execution is dropped.
+     */
+    Drop,
+
+    /**
+     * At most one execution waits behind the running one, any further executions are merged into it.
+     */
+    Merge
+};
+
+/**
+ * A command with its arguments parsed ahead of execution.
+ */
+class Command
+{
+public:
+    /**
+     * Commands containing shell syntax are run through /bin/sh, others are split on whitespace and run directly.
+     */
+    explicit Command(const QString &command);
+    Command(const Command &) = delete;
+
+    /**
+     * @return The command as specified in the constructor.
+     */
+    const QString &command() const;
+
+private:
+    QString m_command;
+    std::vector<std::string> m_arguments;
+    std::vector<char *> m_argv;
+
+    /**
+     * Amount of executions waiting in the queue. Guarded by CommandExecutor::m_mutex.
+     */
+    uint32_t m_queued = 0;
+    /**
+     * Amount of executions currently running. Guarded by CommandExecutor::m_mutex.
+     */
+    uint32_t m_running = 0;
+
+    friend class CommandExecutor;
+    friend class TestCommandExecutor;
+};
+
+/**
+ * Spawns commands from a single worker thread using posix_spawn and reaps them once they exit. How many can run at the
+ * same time is optionally limited.
+ */
+class CommandExecutor
+{
+public:
+    CommandExecutor();
+    ~CommandExecutor();
+
+    /**
+     * Queues an execution of the command.
+     * @return Whether the execution was queued, @c false if it was dropped or merged into a queued one.
+     */
+    bool execute(const std::shared_ptr<Command> &command, const CommandCoalescing &coalescing);
+
+    /**
+     * @param limit Maximum amount of commands running at the same time, 0 for no limit. Long-running commands, such as
+     * launched applications, occupy a slot until they exit.
+     */
+    void setConcurrencyLimit(const uint32_t &limit);
+
+    /**
+     * @return Amount of executions that have exited with status 0.
+     */
+    uint64_t completed() const;
+    /**
+     * @return Amount of executions that couldn't be spawned, including empty commands, or have exited with a non-zero
+     * status or due to a signal.
+     */
+    uint64_t failed() const;
+    /**
+     * @return Amount of executions that have been dropped or merged.
+     */
+    uint64_t dropped() const;
+    /**
+     * @return Amount of executions waiting for a running command to exit.
+     */
+    uint32_t queued() const;
+
+    static CommandExecutor *instance();
+
+private:
+    void run();
+    void finished(const std::shared_ptr<Command> &command, const bool &success);
+    void wake();
+
+    struct Process
+    {
+        std::shared_ptr<Command> command;
+        pid_t pid;
+        /**
+         * -1 if pidfd_open is not supported, in which case the process is polled.
+         */
+        int pidfd;
+    };
+
+    mutable std::mutex m_mutex;
+    std::deque<std::shared_ptr<Command>> m_queue;
+    uint32_t m_concurrencyLimit = 0;
+    bool m_stopping = false;
+
+    std::thread m_thread;
+    /**
+     * Wakes up the worker thread when executions are queued or the executor is stopping.
+     */
+    const int m_eventfd;
+
+    std::atomic<uint64_t> m_completed = 0;
+    std::atomic<uint64_t> m_failed = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+
+    static constexpr size_t s_maxQueued = 64;
+
+    friend class TestCommandExecutor;
+};
+
+}
@@ -5,7 +5,7 @@ namespace libgestures
 
 bool Condition::isSatisfied() const
 {
-    const auto windowData = WindowInfoProvider::implementation()->activeWindow();
+    const auto &windowData = WindowInfoProvider::implementation()->cachedActiveWindow();
     if (!windowData)
         return false;
 
@@ -19,9 +19,7 @@ bool Condition::isWindowClassRegexSubConditionSatisfied(const WindowInfo &data)
         return true;
     }
 
-    return ((*m_windowClass).match(data.resourceClass()).hasMatch()
-            || (*m_windowClass).match(data.resourceName()).hasMatch())
-        == !m_negateWindowClass;
+    return m_windowClass->matches(data) == !m_negateWindowClass;
 }
 
 bool Condition::isWindowStateSubConditionSatisfied(const WindowInfo &data) const
@@ -37,7 +35,7 @@ bool Condition::isWindowStateSubConditionSatisfied(const WindowInfo &data) const
 
 void Condition::setWindowClass(const QRegularExpression &windowClassRegex)
 {
-    m_windowClass = windowClassRegex;
+    m_windowClass = WindowClassMatcher::get(windowClassRegex);
 }
 
 void Condition::setWindowState(const WindowStates &windowState)
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "windowclassmatcher.h"
 #include "windowinfoprovider.h"
 #include <QRegularExpression>
 
@@ -16,7 +17,8 @@ public:
     bool isSatisfied() const;
 
     /**
-     * @param windowClassRegex If empty, the subcondition will always be satisfied.
+     * @param windowClassRegex If empty, the subcondition will always be satisfied. Conditions with identical patterns
+     * share the compiled expression and its last result.
      * @remark Requires @c libgestures::WindowInfoProvider to be implemented.
      */
     void setWindowClass(const QRegularExpression &windowClassRegex);
@@ -33,13 +35,15 @@ private:
     bool isWindowClassRegexSubConditionSatisfied(const WindowInfo &data) const;
     bool isWindowStateSubConditionSatisfied(const WindowInfo &data) const;
 
-    std::optional<QRegularExpression> m_windowClass = std::nullopt;
+    std::shared_ptr<const WindowClassMatcher> m_windowClass;
     bool m_negateWindowClass = false;
 
     WindowStates m_windowState = WindowState::All;
     bool m_negateWindowState = false;
 
+    friend class ConfigCache;
     friend class TestCondition;
+    friend class TestConfigCache;
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,63 @@
+#include "config.h"
+
+#include <QCryptographicHash>
+#include <QThread>
+#include <QtEndian>
+
+namespace libgestures
+{
+
+void Config::moveToThread(QThread *thread) const
+{
+    if (!touchpadGestureRecognizer) {
+        return;
+    }
+
+    touchpadGestureRecognizer->moveToThread(thread);
+    for (const auto &gesture : touchpadGestureRecognizer->gestures()) {
+        // Reused gestures already live in the target thread and can't be moved from here
+        if (gesture->thread() == thread) {
+            continue;
+        }
+
+        gesture->moveToThread(thread);
+        for (const auto &action : gesture->actions()) {
+            action->moveToThread(thread);
+        }
+    }
+}
+
+PreviousGestures::PreviousGestures(const GestureRecognizer *gestureRecognizer)
+{
+    if (!gestureRecognizer) {
+        return;
+    }
+
+    for (const auto &gesture : gestureRecognizer->gestures()) {
+        if (gesture->configHash()) {
+            m_gestures.emplace(gesture->configHash(), gesture);
+        }
+    }
+}
+
+std::shared_ptr<Gesture> PreviousGestures::take(const uint64_t &configHash)
+{
+    const auto it = m_gestures.find(configHash);
+    if (it == m_gestures.end()) {
+        return nullptr;
+    }
+
+    auto gesture = it->second;
+    m_gestures.erase(it);
+    return gesture;
+}
+
+uint64_t PreviousGestures::configHash(const QByteArray &config)
+{
+    const auto digest = QCryptographicHash::hash(config, QCryptographicHash::Sha1);
+    const auto hash = qFromBigEndian<quint64>(digest.constData());
+    // 0 means the gesture wasn't created from a configuration
+    return hash ? hash : 1;
+}
+
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include "gestures/gesturerecognizer.h"
+
+#include <unordered_map>
+
+namespace libgestures
+{
+
+/**
+ * The root of the configuration file.
+ */
+struct Config
+{
+    bool autoReload = true;
+
+    /**
+     * Maximum amount of commands running at the same time, 0 for no limit.
+     */
+    uint32_t commandConcurrency = 0;
+
+    /**
+     * Path of the file input events are recorded to, empty if events shouldn't be recorded.
+     */
+    QString inputTrace;
+
+    std::shared_ptr<GestureRecognizer> touchpadGestureRecognizer;
+
+    /**
+     * Changes the thread affinity of all recognizers, gestures and actions. Must be called from the thread the objects
+     * currently live in.
+     */
+    void moveToThread(QThread *thread) const;
+};
+
+/**
+ * Gestures of a previously loaded configuration that can be reused by a new configuration if their configuration
+ * hasn't changed.
+ */
+class PreviousGestures
+{
+public:
+    /**
+     * @param gestureRecognizer May be nullptr.
+     */
+    explicit PreviousGestures(const GestureRecognizer *gestureRecognizer);
+
+    /**
+     * Removes a gesture with the specified configuration hash from the pool, so that identical gestures are not
+     * shared.
+     * @return The gesture, or nullptr if none has that hash.
+     */
+    std::shared_ptr<Gesture> take(const uint64_t &configHash);
+
+    /**
+     * @return Hash of a gesture's configuration. Stable across runs and standard libraries, as it is stored in the
+     * configuration cache. Never 0.
+     */
+    static uint64_t configHash(const QByteArray &config);
+
+private:
+    std::unordered_multimap<uint64_t, std::shared_ptr<Gesture>> m_gestures;
+};
+
+}
@@ -0,0 +1,444 @@
+#include "configcache.h"
+
+#include "actions/command.h"
+#include "actions/input.h"
+#include "actions/plasmaglobalshortcut.h"
+
+#include <QCryptographicHash>
+#include <QDir>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+namespace libgestures
+{
+
+enum class ActionType : quint8 {
+    Command,
+    Input,
+    PlasmaGlobalShortcut
+};
+
+static constexpr auto s_streamVersion = QDataStream::Qt_6_6;
+
+template<typename T>
+static void writeVector(QDataStream &stream, const std::vector<T> &vector)
+{
+    stream << static_cast<quint32>(vector.size());
+    for (const auto &element : vector) {
+        stream << element;
+    }
+}
+
+template<typename T>
+static std::vector<T> readVector(QDataStream &stream)
+{
+    quint32 size = 0;
+    stream >> size;
+
+    std::vector<T> vector;
+    for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; i++) {
+        T element;
+        stream >> element;
+        vector.push_back(element);
+    }
+    return vector;
+}
+
+ConfigCache::ConfigCache(const QString &configFilePath)
+    : m_configFilePath(configFilePath)
+{
+    const QFileInfo configFile(configFilePath);
+    m_path = configFile.dir().filePath(configFile.completeBaseName() + ".cache");
+}
+
+ConfigCache::Key ConfigCache::key(const QByteArray &content) const
+{
+    return {
+        .modificationTime = QFileInfo(m_configFilePath).lastModified().toMSecsSinceEpoch(),
+        .size = content.size(),
+        .hash = QCryptographicHash::hash(content, QCryptographicHash::Sha1),
+    };
+}
+
+std::optional<ConfigCache::Key> ConfigCache::unchangedKey() const
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(s_streamVersion);
+    Key key;
+    if (!readHeader(stream, key)) {
+        return std::nullopt;
+    }
+
+    const QFileInfo configFile(m_configFilePath);
+    if (key.modificationTime != configFile.lastModified().toMSecsSinceEpoch() || key.size != configFile.size()) {
+        return std::nullopt;
+    }
+    return key;
+}
+
+bool ConfigCache::readHeader(QDataStream &stream, Key &key)
+{
+    quint32 magic = 0;
+    quint32 version = 0;
+    stream >> magic >> version;
+    if (magic != s_magic || version != s_version) {
+        return false;
+    }
+    stream >> key.modificationTime >> key.size >> key.hash;
+    return stream.status() == QDataStream::Ok;
+}
+
+std::optional<Config> ConfigCache::load(const Key &key, const Config *previous) const
+{
+    QFile file(m_path);
+    if (!file.open(QIODevice::ReadOnly) || file.size() == 0) {
+        return std::nullopt;
+    }
+    const auto data = file.map(0, file.size());
+    if (!data) {
+        return std::nullopt;
+    }
+
+    const auto raw = QByteArray::fromRawData(reinterpret_cast<const char *>(data), file.size());
+    QDataStream stream(raw);
+    stream.setVersion(s_streamVersion);
+
+    Key cachedKey;
+    if (!readHeader(stream, cachedKey) || cachedKey != key) {
+        return std::nullopt;
+    }
+
+    Config config;
+    stream >> config.autoReload >> config.commandConcurrency >> config.inputTrace;
+    config.touchpadGestureRecognizer = readGestureRecognizer(stream, previous ? previous->touchpadGestureRecognizer.get() : nullptr);
+    if (stream.status() != QDataStream::Ok || !stream.atEnd()) {
+        return std::nullopt;
+    }
+    return config;
+}
+
+bool ConfigCache::save(const Key &key, const Config &config) const
+{
+    QSaveFile file(m_path);
+    if (!file.open(QIODevice::WriteOnly)) {
+        return false;
+    }
+
+    QDataStream stream(&file);
+    stream.setVersion(s_streamVersion);
+    stream << s_magic << s_version << key.modificationTime << key.size << key.hash;
+    stream << config.autoReload << config.commandConcurrency << config.inputTrace;
+    write(stream, *config.touchpadGestureRecognizer);
+
+    return stream.status() == QDataStream::Ok && file.commit();
+}
+
+const QString &ConfigCache::path() const
+{
+    return m_path;
+}
+
+void ConfigCache::write(QDataStream &stream, const GestureRecognizer &gestureRecognizer)
+{
+    stream << gestureRecognizer.m_speedSampleTime << gestureRecognizer.m_swipeGestureFastThreshold
+           << gestureRecognizer.m_pinchInFastThreshold << gestureRecognizer.m_pinchOutFastThreshold
+           << gestureRecognizer.m_rotateFastThreshold << gestureRecognizer.m_deltaMultiplier << gestureRecognizer.m_scrollTimeout;
+
+    // Gestures are prefixed with their configuration hash and size, so that reused gestures can be skipped
+    stream << static_cast<quint32>(gestureRecognizer.m_gestures.size());
+    for (const auto &gesture : gestureRecognizer.m_gestures) {
+        QByteArray data;
+        QDataStream gestureStream(&data, QIODevice::WriteOnly);
+        gestureStream.setVersion(s_streamVersion);
+        write(gestureStream, *gesture);
+        if (gestureStream.status() != QDataStream::Ok) {
+            stream.setStatus(QDataStream::WriteFailed);
+            return;
+        }
+
+        stream << static_cast<quint64>(gesture->configHash()) << static_cast<quint32>(data.size());
+        stream.writeRawData(data.constData(), data.size());
+    }
+}
+
+std::shared_ptr<GestureRecognizer> ConfigCache::readGestureRecognizer(QDataStream &stream, const GestureRecognizer *previous)
+{
+    auto gestureRecognizer = std::make_shared<GestureRecognizer>();
+    uint32_t speedSampleTime, scrollTimeout;
+    qreal swipeFastThreshold, pinchInFastThreshold, pinchOutFastThreshold, rotateFastThreshold, deltaMultiplier;
+    stream >> speedSampleTime >> swipeFastThreshold >> pinchInFastThreshold >> pinchOutFastThreshold >> rotateFastThreshold
+        >> deltaMultiplier >> scrollTimeout;
+    gestureRecognizer->setSpeedSampleTime(speedSampleTime);
+    gestureRecognizer->setSwipeFastThreshold(swipeFastThreshold);
+    gestureRecognizer->setPinchInFastThreshold(pinchInFastThreshold);
+    gestureRecognizer->setPinchOutFastThreshold(pinchOutFastThreshold);
+    gestureRecognizer->setRotateFastThreshold(rotateFastThreshold);
+    gestureRecognizer->setDeltaMultiplier(deltaMultiplier);
+    gestureRecognizer->setScrollTimeout(scrollTimeout);
+
+    PreviousGestures previousGestures(previous);
+    quint32 gestures = 0;
+    stream >> gestures;
+    for (quint32 i = 0; i < gestures && stream.status() == QDataStream::Ok; i++) {
+        quint64 hash = 0;
+        quint32 size = 0;
+        stream >> hash >> size;
+
+        auto gesture = hash ? previousGestures.take(hash) : nullptr;
+        if (gesture) {
+            if (stream.skipRawData(size) != static_cast<int>(size)) {
+                stream.setStatus(QDataStream::ReadPastEnd);
+            }
+        } else if ((gesture = readGesture(stream))) {
+            gesture->setConfigHash(hash);
+        }
+
+        if (gesture) {
+            gestureRecognizer->registerGesture(gesture);
+        }
+    }
+    return gestureRecognizer;
+}
+
+void ConfigCache::write(QDataStream &stream, const Gesture &gesture)
+{
+    stream << static_cast<quint8>(gesture.type());
+    switch (gesture.type()) {
+    case GestureType::Hold:
+        break;
+    case GestureType::Pinch:
+        stream << static_cast<quint8>(static_cast<const PinchGesture &>(gesture).direction());
+        break;
+    case GestureType::Rotate:
+        stream << static_cast<quint8>(static_cast<const RotateGesture &>(gesture).direction());
+        break;
+    case GestureType::Swipe:
+        stream << static_cast<quint8>(static_cast<const SwipeGesture &>(gesture).direction());
+        break;
+    }
+
+    stream << gesture.m_minimumFingers << gesture.m_maximumFingers << gesture.m_minimumThreshold << gesture.m_maximumThreshold
+           << static_cast<quint8>(gesture.m_speed) << gesture.m_modifiers.has_value()
+           << gesture.m_modifiers.value_or(Qt::KeyboardModifier::NoModifier).toInt();
+
+    stream << static_cast<quint32>(gesture.m_conditions.size());
+    for (const auto &condition : gesture.m_conditions) {
+        write(stream, *condition);
+    }
+    stream << static_cast<quint32>(gesture.m_actions.size());
+    for (const auto &action : gesture.m_actions) {
+        write(stream, *action);
+    }
+}
+
+std::shared_ptr<Gesture> ConfigCache::readGesture(QDataStream &stream)
+{
+    quint8 type = 0;
+    stream >> type;
+
+    std::shared_ptr<Gesture> gesture;
+    quint8 direction = 0;
+    switch (static_cast<GestureType>(type)) {
+    case GestureType::Hold:
+        gesture = std::make_shared<HoldGesture>();
+        break;
+    case GestureType::Pinch: {
+        auto pinchGesture = std::make_shared<PinchGesture>();
+        stream >> direction;
+        pinchGesture->setDirection(static_cast<PinchDirection>(direction));
+        gesture = pinchGesture;
+        break;
+    }
+    case GestureType::Rotate: {
+        auto rotateGesture = std::make_shared<RotateGesture>();
+        stream >> direction;
+        rotateGesture->setDirection(static_cast<RotateDirection>(direction));
+        gesture = rotateGesture;
+        break;
+    }
+    case GestureType::Swipe: {
+        auto swipeGesture = std::make_shared<SwipeGesture>();
+        stream >> direction;
+        swipeGesture->setDirection(static_cast<SwipeDirection>(direction));
+        gesture = swipeGesture;
+        break;
+    }
+    default:
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return nullptr;
+    }
+
+    uint8_t minimumFingers, maximumFingers;
+    qreal minimumThreshold, maximumThreshold;
+    quint8 speed;
+    bool hasModifiers;
+    int modifiers;
+    stream >> minimumFingers >> maximumFingers >> minimumThreshold >> maximumThreshold >> speed >> hasModifiers >> modifiers;
+    gesture->setFingers(minimumFingers, maximumFingers);
+    gesture->setThresholds(minimumThreshold, maximumThreshold);
+    gesture->setSpeed(static_cast<GestureSpeed>(speed));
+    if (hasModifiers) {
+        gesture->setKeyboardModifiers(Qt::KeyboardModifiers::fromInt(modifiers));
+    } else {
+        gesture->setKeyboardModifiers(std::nullopt);
+    }
+
+    quint32 conditions = 0;
+    stream >> conditions;
+    for (quint32 i = 0; i < conditions && stream.status() == QDataStream::Ok; i++) {
+        gesture->addCondition(readCondition(stream));
+    }
+    quint32 actions = 0;
+    stream >> actions;
+    for (quint32 i = 0; i < actions && stream.status() == QDataStream::Ok; i++) {
+        if (auto action = readAction(stream)) {
+            gesture->addAction(action);
+        }
+    }
+    return gesture;
+}
+
+void ConfigCache::write(QDataStream &stream, const GestureAction &action)
+{
+    if (const auto commandAction = dynamic_cast<const CommandGestureAction *>(&action)) {
+        stream << static_cast<quint8>(ActionType::Command) << commandAction->m_command->command()
+               << static_cast<quint8>(commandAction->m_coalescing);
+    } else if (const auto inputAction = dynamic_cast<const InputGestureAction *>(&action)) {
+        stream << static_cast<quint8>(ActionType::Input) << static_cast<quint32>(inputAction->m_sequence.size());
+        for (const auto &inputActionItem : inputAction->m_sequence) {
+            write(stream, inputActionItem);
+        }
+    } else if (const auto plasmaShortcutAction = dynamic_cast<const PlasmaGlobalShortcutGestureAction *>(&action)) {
+        stream << static_cast<quint8>(ActionType::PlasmaGlobalShortcut) << plasmaShortcutAction->m_component
+               << plasmaShortcutAction->m_shortcut;
+    } else {
+        stream.setStatus(QDataStream::WriteFailed);
+        return;
+    }
+
+    stream << static_cast<quint8>(action.m_on) << action.m_minimumThreshold << action.m_maximumThreshold << action.m_repeatInterval
+           << action.m_blockOtherActions;
+    stream << static_cast<quint32>(action.m_conditions.size());
+    for (const auto &condition : action.m_conditions) {
+        write(stream, *condition);
+    }
+}
+
+std::shared_ptr<GestureAction> ConfigCache::readAction(QDataStream &stream)
+{
+    quint8 type = 0;
+    stream >> type;
+
+    std::shared_ptr<GestureAction> action;
+    switch (static_cast<ActionType>(type)) {
+    case ActionType::Command: {
+        auto commandAction = std::make_shared<CommandGestureAction>();
+        QString command;
+        quint8 coalescing;
+        stream >> command >> coalescing;
+        commandAction->setCommand(command);
+        commandAction->setCoalescing(static_cast<CommandCoalescing>(coalescing));
+        action = commandAction;
+        break;
+    }
+    case ActionType::Input: {
+        auto inputAction = std::make_shared<InputGestureAction>();
+        quint32 size = 0;
+        stream >> size;
+        std::vector<InputAction> sequence;
+        for (quint32 i = 0; i < size && stream.status() == QDataStream::Ok; i++) {
+            sequence.push_back(readInputAction(stream));
+        }
+        inputAction->setSequence(sequence);
+        action = inputAction;
+        break;
+    }
+    case ActionType::PlasmaGlobalShortcut: {
+        auto plasmaShortcutAction = std::make_shared<PlasmaGlobalShortcutGestureAction>();
+        QString component, shortcut;
+        stream >> component >> shortcut;
+        plasmaShortcutAction->setComponent(component);
+        plasmaShortcutAction->setShortcut(shortcut);
+        action = plasmaShortcutAction;
+        break;
+    }
+    default:
+        stream.setStatus(QDataStream::ReadCorruptData);
+        return nullptr;
+    }
+
+    quint8 on;
+    qreal minimumThreshold, maximumThreshold, repeatInterval;
+    bool blockOtherActions;
+    stream >> on >> minimumThreshold >> maximumThreshold >> repeatInterval >> blockOtherActions;
+    action->setOn(static_cast<On>(on));
+    action->setThresholds(minimumThreshold, maximumThreshold);
+    action->setRepeatInterval(repeatInterval);
+    action->setBlockOtherActions(blockOtherActions);
+
+    quint32 conditions = 0;
+    stream >> conditions;
+    for (quint32 i = 0; i < conditions && stream.status() == QDataStream::Ok; i++) {
+        action->addCondition(readCondition(stream));
+    }
+    return action;
+}
+
+void ConfigCache::write(QDataStream &stream, const Condition &condition)
+{
+    stream << static_cast<bool>(condition.m_windowClass);
+    if (condition.m_windowClass) {
+        stream << condition.m_windowClass->pattern() << condition.m_windowClass->patternOptions().toInt();
+    }
+    stream << condition.m_negateWindowClass << condition.m_windowState.toInt() << condition.m_negateWindowState;
+}
+
+std::shared_ptr<Condition> ConfigCache::readCondition(QDataStream &stream)
+{
+    auto condition = std::make_shared<Condition>();
+
+    bool hasWindowClass = false;
+    stream >> hasWindowClass;
+    if (hasWindowClass) {
+        QString windowClass;
+        int options;
+        stream >> windowClass >> options;
+        condition->setWindowClass(QRegularExpression(windowClass, QRegularExpression::PatternOptions::fromInt(options)));
+    }
+
+    bool negateWindowClass, negateWindowState;
+    int windowState;
+    stream >> negateWindowClass >> windowState >> negateWindowState;
+    condition->setNegateWindowClass(negateWindowClass);
+    condition->setWindowState(WindowStates::fromInt(windowState));
+    condition->setNegateWindowState(negateWindowState);
+    return condition;
+}
+
+void ConfigCache::write(QDataStream &stream, const InputAction &action)
+{
+    writeVector(stream, action.keyboardPress);
+    writeVector(stream, action.keyboardRelease);
+    writeVector(stream, action.mousePress);
+    writeVector(stream, action.mouseRelease);
+    stream << action.mouseMoveAbsolute << action.mouseMoveRelative << action.mouseMoveRelativeByDelta;
+}
+
+InputAction ConfigCache::readInputAction(QDataStream &stream)
+{
+    InputAction action;
+    action.keyboardPress = readVector<uint32_t>(stream);
+    action.keyboardRelease = readVector<uint32_t>(stream);
+    action.mousePress = readVector<uint32_t>(stream);
+    action.mouseRelease = readVector<uint32_t>(stream);
+    stream >> action.mouseMoveAbsolute >> action.mouseMoveRelative >> action.mouseMoveRelativeByDelta;
+    return action;
+}
+
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include "config.h"
+#include "actions/input.h"
+
+#include <QByteArray>
+#include <QDataStream>
+#include <QString>
+
+namespace libgestures
+{
+
+/**
+ * Stores a parsed configuration in a binary file next to the configuration file, so that it can be loaded without
+ * parsing the YAML.
+ */
+class ConfigCache
+{
+public:
+    /**
+     * Identifies the contents of the configuration file the cache was created from.
+     */
+    struct Key
+    {
+        qint64 modificationTime = 0;
+        qint64 size = 0;
+        QByteArray hash;
+
+        bool operator==(const Key &other) const = default;
+    };
+
+    /**
+     * @param configFilePath The cache is stored in the same directory, with the same base name and the .cache suffix.
+     */
+    explicit ConfigCache(const QString &configFilePath);
+
+    /**
+     * @param content Contents of the configuration file.
+     */
+    Key key(const QByteArray &content) const;
+
+    /**
+     * Compares the modification time and size of the configuration file to the key the cache was created from, so that
+     * an unchanged file doesn't need to be read and hashed.
+     * @return The key of the cache, or std::nullopt if the cache doesn't exist, was created by a different version or
+     * the modification time or size of the configuration file differs.
+     * @remark A file modified within the same millisecond without changing its size is considered unchanged.
+     */
+    std::optional<Key> unchangedKey() const;
+
+    /**
+     * Maps the cache file into memory and deserializes it.
+     * @param previous The previously loaded configuration. Gestures with the same configuration hash are reused
+     * instead of being deserialized. May be nullptr.
+     * @return The cached configuration, or std::nullopt if the cache doesn't exist, is corrupted, was created by a
+     * different version or from a configuration file with a different key.
+     */
+    std::optional<Config> load(const Key &key, const Config *previous = nullptr) const;
+
+    /**
+     * Replaces the cache file atomically.
+     * @param key The key of the configuration file @p config was parsed from.
+     * @return Whether the cache has been written successfully.
+     */
+    bool save(const Key &key, const Config &config) const;
+
+    const QString &path() const;
+
+private:
+    /**
+     * Reads the magic number, version and key.
+     * @return Whether the cache was created by this version.
+     */
+    static bool readHeader(QDataStream &stream, Key &key);
+
+    static void write(QDataStream &stream, const GestureRecognizer &gestureRecognizer);
+    static void write(QDataStream &stream, const Gesture &gesture);
+    static void write(QDataStream &stream, const GestureAction &action);
+    static void write(QDataStream &stream, const Condition &condition);
+    static void write(QDataStream &stream, const InputAction &action);
+
+    static std::shared_ptr<GestureRecognizer> readGestureRecognizer(QDataStream &stream, const GestureRecognizer *previous);
+    static std::shared_ptr<Gesture> readGesture(QDataStream &stream);
+    static std::shared_ptr<GestureAction> readAction(QDataStream &stream);
+    static std::shared_ptr<Condition> readCondition(QDataStream &stream);
+    static InputAction readInputAction(QDataStream &stream);
+
+    QString m_configFilePath;
+    QString m_path;
+
+    static constexpr quint32 s_magic = 0x4B574743; // KWGC
+    /**
+     * Must be incremented whenever the format changes.
+     */
+    static constexpr quint32 s_version = 7;
+};
+
+}
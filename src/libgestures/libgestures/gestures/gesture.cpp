@@ -5,77 +5,72 @@
 namespace libgestures
 {
 
-Gesture::Gesture()
-{
-    connect(this, &Gesture::cancelled, this, &Gesture::onCancelled);
-    connect(this, &Gesture::ended, this, &Gesture::onEnded);
-    connect(this, &Gesture::started, this, &Gesture::onStarted);
-    connect(this, &Gesture::updated, this, &Gesture::onUpdated);
-}
-
-void Gesture::onCancelled()
+void Gesture::cancel()
 {
     m_absoluteAccumulatedDelta = 0;
 
-    if (!m_hasStarted)
-        return;
-
-    m_hasStarted = false;
+    if (m_hasStarted) {
+        m_hasStarted = false;
 
-    for (const auto &action : m_actions) {
-        Q_EMIT action->gestureCancelled();
-        if (action->blocksOtherActions())
-            break;
+        for (const auto &action : m_actions) {
+            action->onGestureCancelled();
+            if (action->blocksOtherActions())
+                break;
+        }
     }
+
+    Q_EMIT cancelled();
 }
 
-void Gesture::onEnded()
+void Gesture::end()
 {
     m_absoluteAccumulatedDelta = 0;
 
-    if (!m_hasStarted)
-        return;
-
-    m_hasStarted = false;
+    if (m_hasStarted) {
+        m_hasStarted = false;
 
-    for (const auto &action : m_actions) {
-        Q_EMIT action->gestureEnded();
-        if (action->blocksOtherActions())
-            break;
+        for (const auto &action : m_actions) {
+            action->onGestureEnded();
+            if (action->blocksOtherActions())
+                break;
+        }
     }
+
+    Q_EMIT ended();
 }
 
-void Gesture::onStarted()
+void Gesture::start()
 {
-    if (!m_hasStarted)
-        return;
+    m_hasStarted = true;
 
     for (const auto &action : m_actions) {
-        Q_EMIT action->gestureStarted();
+        action->onGestureStarted();
         if (action->blocksOtherActions())
             break;
     }
+
+    Q_EMIT started();
 }
 
-void Gesture::onUpdated(const qreal &delta, const QPointF &deltaPointMultiplied, bool &endedPrematurely)
+void Gesture::update(const qreal &delta, const QPointF &deltaPointMultiplied, bool &endedPrematurely)
 {
     m_absoluteAccumulatedDelta += std::abs(delta);
-    if (!thresholdReached())
-        return;
-
-    if (!m_hasStarted) {
-        m_hasStarted = true;
-        Q_EMIT started();
-    }
+    if (thresholdReached()) {
+        if (!m_hasStarted) {
+            start();
+        }
 
-    for (const auto &action : m_actions) {
-        Q_EMIT action->gestureUpdated(delta, deltaPointMultiplied);
-        if (action->blocksOtherActions()) {
-            endedPrematurely = true;
-            Q_EMIT ended();
-            return;
+        for (const auto &action : m_actions) {
+            action->onGestureUpdated(delta, deltaPointMultiplied);
+            if (action->blocksOtherActions()) {
+                endedPrematurely = true;
+                end();
+                break;
+            }
         }
     }
+
+    Q_EMIT updated(delta, deltaPointMultiplied, endedPrematurely);
 }
 
 bool Gesture::satisfiesBeginConditions(const uint8_t &fingerCount) const
@@ -98,9 +93,48 @@ bool Gesture::satisfiesBeginConditions(const uint8_t &fingerCount) const
     return m_actions.empty() || actionSatisfiesConditions;
 }
 
-bool Gesture::satisfiesUpdateConditions(const GestureSpeed &speed) const
+std::optional<qreal> Gesture::remainingDelta() const
 {
-    return m_speed == GestureSpeed::Any || m_speed == speed;
+    if (m_maximumThreshold != 0 && m_absoluteAccumulatedDelta > m_maximumThreshold)
+        return std::nullopt;
+    if (m_minimumThreshold != 0 && m_absoluteAccumulatedDelta < m_minimumThreshold)
+        return m_minimumThreshold - m_absoluteAccumulatedDelta;
+    if (!m_hasStarted)
+        return 0;
+
+    std::optional<qreal> remaining;
+    for (const auto &action : m_actions) {
+        const auto actionRemaining = action->remainingDelta();
+        if (actionRemaining && (!remaining || *actionRemaining < *remaining))
+            remaining = actionRemaining;
+        if (action->blocksOtherActions())
+            break;
+    }
+    return remaining;
+}
+
+const uint32_t &Gesture::acceptedUpdates() const
+{
+    return m_acceptedUpdates;
+}
+
+void Gesture::setAcceptedDirections(const uint32_t &directions)
+{
+    m_acceptedDirections = directions;
+    updateAcceptedUpdates();
+}
+
+void Gesture::updateAcceptedUpdates()
+{
+    // Updates are performed at the speed Any if no active gesture has a speed set
+    const uint32_t speeds = m_speed == GestureSpeed::Any ? 0b111 : 1u << static_cast<uint8_t>(m_speed);
+
+    m_acceptedUpdates = 0;
+    for (uint8_t direction = 0; direction < s_updateKinds / 3; direction++) {
+        if (m_acceptedDirections & (1u << direction)) {
+            m_acceptedUpdates |= speeds << updateKind(direction, GestureSpeed::Any);
+        }
+    }
 }
 
 void Gesture::addAction(const std::shared_ptr<GestureAction> &action)
@@ -139,6 +173,7 @@ bool Gesture::thresholdReached() const
 void Gesture::setSpeed(const libgestures::GestureSpeed &speed)
 {
     m_speed = speed;
+    updateAcceptedUpdates();
 }
 
 const GestureSpeed &Gesture::speed() const
@@ -146,9 +181,34 @@ const GestureSpeed &Gesture::speed() const
     return m_speed;
 }
 
+const uint8_t &Gesture::minimumFingers() const
+{
+    return m_minimumFingers;
+}
+
+const uint8_t &Gesture::maximumFingers() const
+{
+    return m_maximumFingers;
+}
+
 const std::optional<Qt::KeyboardModifiers> &Gesture::keyboardModifiers() const
 {
     return m_modifiers;
 }
 
+const std::vector<std::shared_ptr<GestureAction>> &Gesture::actions() const
+{
+    return m_actions;
+}
+
+const uint64_t &Gesture::configHash() const
+{
+    return m_configHash;
+}
+
+void Gesture::setConfigHash(const uint64_t &hash)
+{
+    m_configHash = hash;
+}
+
 }
\ No newline at end of file
@@ -13,11 +13,33 @@ enum class GestureSpeed {
     Fast
 };
 
+/**
+ * Amount of distinct update kinds (single direction and speed combinations). Swipe gestures have 4 single directions,
+ * and there are 3 speeds.
+ */
+static constexpr uint8_t s_updateKinds = 4 * 3;
+
+/**
+ * @param directionIndex Index of a single direction of the gesture type, starting from 0.
+ * @return Index of the bit representing updates in the specified direction at the specified speed.
+ */
+constexpr uint8_t updateKind(const uint8_t &directionIndex, const GestureSpeed &speed)
+{
+    return directionIndex * 3 + static_cast<uint8_t>(speed);
+}
+
+enum class GestureType {
+    Hold,
+    Pinch,
+    Rotate,
+    Swipe
+};
+
 class Gesture : public QObject
 {
     Q_OBJECT
 public:
-    Gesture();
+    Gesture() = default;
 
     /**
      * @returns Whether the amount of fingers fits within the specified range, all (if any) conditions are
@@ -25,8 +47,36 @@ public:
      */
     bool satisfiesBeginConditions(const uint8_t &fingerCount) const;
 
+    /**
+     * @return How much more delta needs to be accumulated before an update can have any effect on this gesture or its
+     * actions, 0 if any update can, or std::nullopt if no update ever will.
+     * @remark Assumes that all future deltas are positive, which is only guaranteed for hold gestures.
+     */
+    std::optional<qreal> remainingDelta() const;
+
+    /**
+     * Used by the gesture recognizer to index gestures without having to cast them.
+     */
+    virtual GestureType type() const = 0;
+
     const GestureSpeed &speed() const;
+    const uint8_t &minimumFingers() const;
+    const uint8_t &maximumFingers() const;
     const std::optional<Qt::KeyboardModifiers> &keyboardModifiers() const;
+    const std::vector<std::shared_ptr<GestureAction>> &actions() const;
+
+    /**
+     * @return Bitmask of update kinds (see updateKind) that satisfy the direction and speed of this gesture. Updates of
+     * other kinds cancel the gesture.
+     */
+    const uint32_t &acceptedUpdates() const;
+
+    /**
+     * @return Hash of the configuration this gesture was created from, used to preserve unchanged gestures when the
+     * configuration is reloaded. 0 if the gesture wasn't created from a configuration.
+     */
+    const uint64_t &configHash() const;
+    void setConfigHash(const uint64_t &hash);
 
     void addAction(const std::shared_ptr<GestureAction> &action);
     void addCondition(const std::shared_ptr<const Condition> &condition);
@@ -40,7 +90,29 @@ public:
      * else - all specified modifiers must be active
      */
     void setKeyboardModifiers(const std::optional<Qt::KeyboardModifiers> &modifiers);
+
+    /**
+     * Cancels the gesture and notifies its actions.
+     */
+    void cancel();
+
+    /**
+     * Ends the gesture and notifies its actions.
+     */
+    void end();
+
+    /**
+     * Updates the gesture, starts it if the threshold has been reached and notifies its actions.
+     *
+     * @param endedPrematurely Whether the gesture recognizer should end the gesture. Used when only one action can be
+     * triggered.
+     */
+    void update(const qreal &delta, const QPointF &deltaPointMultiplied, bool &endedPrematurely);
 signals:
+    // Only emitted for observers, actions are notified directly. The signals are emitted after the gesture and its
+    // actions have handled the event, so observers see the effects of the actions, same as when the signals were
+    // connected to the handlers.
+
     /**
      * Emitted when the gesture has been cancelled.
      */
@@ -58,7 +130,7 @@ signals:
     void started();
 
     /**
-     * Emitted when the gesture has been updated.
+     * Emitted when the gesture has been updated, including updates received before the threshold has been reached.
      *
      * @param endedPrematurely Whether the gesture recognizer should end the gesture. Used when only one action can be
      * triggered.
@@ -66,15 +138,15 @@ signals:
     void updated(const qreal &delta, const QPointF &deltaPointMultiplied, bool &endedPrematurely);
 
 protected:
-    bool satisfiesUpdateConditions(const GestureSpeed &speed) const;
-
-private slots:
-    void onCancelled();
-    void onEnded();
-    void onStarted();
-    void onUpdated(const qreal &delta, const QPointF &deltaPointMultiplied, bool &endedPrematurely);
+    /**
+     * @param directions Bitmask of the indices of single directions that satisfy the direction of this gesture.
+     */
+    void setAcceptedDirections(const uint32_t &directions);
 
 private:
+    void start();
+    void updateAcceptedUpdates();
+
     /**
      * @return Whether the accumulated delta fits within the specified range.
      */
@@ -85,14 +157,22 @@ private:
     qreal m_minimumThreshold = 0;
     qreal m_maximumThreshold = 0;
     GestureSpeed m_speed = GestureSpeed::Any;
+    uint32_t m_acceptedDirections = 0;
+    uint32_t m_acceptedUpdates = 0;
     std::optional<Qt::KeyboardModifiers> m_modifiers = std::nullopt;
 
     std::vector<std::shared_ptr<const Condition>> m_conditions;
 
     std::vector<std::shared_ptr<GestureAction>> m_actions;
 
+    uint64_t m_configHash = 0;
+
     qreal m_absoluteAccumulatedDelta = 0;
     bool m_hasStarted = false;
+
+    friend class ConfigCache;
+    friend class TestConfigCache;
+    friend class TestGesture;
 };
 
 }
\ No newline at end of file
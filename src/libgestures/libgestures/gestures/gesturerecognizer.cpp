@@ -5,10 +5,10 @@
 namespace libgestures
 {
 
-#define TEMPLATES(TGesture)                                                                                                                      \
-    template void GestureRecognizer::gestureBegin<TGesture>(const uint8_t &fingerCount, std::vector<std::shared_ptr<TGesture>> &activeGestures); \
-    template bool GestureRecognizer::gestureEnd<TGesture>(std::vector<std::shared_ptr<TGesture>> & activeGestures);                              \
-    template void GestureRecognizer::gestureCancel<TGesture>(std::vector<std::shared_ptr<TGesture>> & activeGestures);
+#define TEMPLATES(TGesture)                                                                                                \
+    template void GestureRecognizer::gestureBegin<TGesture>(const uint8_t &fingerCount, ActiveGestures<TGesture> &activeGestures); \
+    template bool GestureRecognizer::gestureEnd<TGesture>(ActiveGestures<TGesture> & activeGestures);                              \
+    template void GestureRecognizer::gestureCancel<TGesture>(ActiveGestures<TGesture> & activeGestures);
 TEMPLATES(HoldGesture)
 TEMPLATES(PinchGesture)
 TEMPLATES(SwipeGesture)
@@ -16,16 +16,100 @@ TEMPLATES(SwipeGesture)
 void GestureRecognizer::registerGesture(std::shared_ptr<Gesture> gesture)
 {
     m_gestures.push_back(gesture);
+
+    switch (gesture->type()) {
+    case GestureType::Hold:
+        indexGesture(static_cast<HoldGesture *>(gesture.get()), m_holdGestures, m_activeHoldGestures);
+        break;
+    case GestureType::Pinch:
+        indexGesture(static_cast<PinchGesture *>(gesture.get()), m_pinchGestures, m_activePinchGestures);
+        break;
+    case GestureType::Rotate:
+        indexGesture(static_cast<RotateGesture *>(gesture.get()), m_rotateGestures, m_activeRotateGestures);
+        break;
+    case GestureType::Swipe:
+        indexGesture(static_cast<SwipeGesture *>(gesture.get()), m_swipeGestures, m_activeSwipeGestures);
+        break;
+    }
 }
 
 void GestureRecognizer::unregisterGestures()
 {
+    // Active gestures are not owned
+    gestureCancel(m_activeHoldGestures);
+    swipeGestureCancel();
+    pinchGestureCancel();
+
     m_gestures.clear();
+    for (auto &bucket : m_holdGestures)
+        bucket.clear();
+    for (auto &bucket : m_pinchGestures)
+        bucket.clear();
+    for (auto &bucket : m_rotateGestures)
+        bucket.clear();
+    for (auto &bucket : m_swipeGestures)
+        bucket.clear();
+}
+
+const std::vector<std::shared_ptr<Gesture>> &GestureRecognizer::gestures() const
+{
+    return m_gestures;
+}
+
+bool GestureRecognizer::hasGestures(const GestureType &type, const uint8_t &fingerCount) const
+{
+    if (fingerCount > s_maxFingerCount)
+        return false;
+
+    switch (type) {
+    case GestureType::Hold:
+        return !m_holdGestures[fingerCount].gestures.empty();
+    case GestureType::Pinch:
+        return !m_pinchGestures[fingerCount].gestures.empty();
+    case GestureType::Rotate:
+        return !m_rotateGestures[fingerCount].gestures.empty();
+    case GestureType::Swipe:
+        return !m_swipeGestures[fingerCount].gestures.empty();
+    }
+    Q_UNREACHABLE();
+}
+
+bool GestureRecognizer::hasActiveGestures() const
+{
+    return !m_activeHoldGestures.empty() || !m_activePinchGestures.empty() || !m_activeRotateGestures.empty()
+        || !m_activeSwipeGestures.empty();
 }
 
-void GestureRecognizer::setInputEventsToSample(const uint8_t &events)
+template<class TGesture>
+void GestureRecognizer::indexGesture(TGesture *gesture, GestureIndex<TGesture> &index, ActiveGestures<TGesture> &activeGestures)
 {
-    m_inputEventsToSample = events;
+    const auto maximumFingers = std::min(gesture->maximumFingers(), s_maxFingerCount);
+    for (auto fingers = gesture->minimumFingers(); fingers <= maximumFingers; fingers++) {
+        index[fingers].push_back(gesture);
+        activeGestures.reserve(index[fingers].gestures.size());
+    }
+}
+
+template<class TGesture>
+const GestureRecognizer::GestureIndex<TGesture> &GestureRecognizer::gestureIndex() const
+{
+    if constexpr (std::is_same_v<TGesture, HoldGesture>) {
+        return m_holdGestures;
+    } else if constexpr (std::is_same_v<TGesture, PinchGesture>) {
+        return m_pinchGestures;
+    } else if constexpr (std::is_same_v<TGesture, RotateGesture>) {
+        return m_rotateGestures;
+    } else {
+        static_assert(std::is_same_v<TGesture, SwipeGesture>);
+        return m_swipeGestures;
+    }
+}
+
+void GestureRecognizer::setSpeedSampleTime(const uint32_t &time)
+{
+    m_speedSampleTime = time;
+    // Samples older than the sample time have less than 5% weight
+    m_kinematics.setTimeConstant(time / 3000.0);
 }
 
 void GestureRecognizer::setSwipeFastThreshold(const qreal &threshold)
@@ -53,19 +137,55 @@ void GestureRecognizer::setDeltaMultiplier(const qreal &deltaMultiplier)
     m_deltaMultiplier = deltaMultiplier;
 }
 
-void GestureRecognizer::holdGestureUpdate(const qreal &delta, bool &endedPrematurely)
+void GestureRecognizer::setScrollTimeout(const uint32_t &timeout)
+{
+    m_scrollTimeout = timeout;
+}
+
+const uint32_t &GestureRecognizer::scrollTimeout() const
+{
+    return m_scrollTimeout;
+}
+
+void GestureRecognizer::holdGestureUpdate(const std::chrono::microseconds &time, bool &endedPrematurely)
 {
-    for (const auto &holdGesture : m_activeHoldGestures) {
-        Q_EMIT holdGesture->updated(delta, QPointF(), endedPrematurely);
+    const std::chrono::duration<qreal, std::milli> delta = time - std::exchange(m_previousEventTime, time);
+    for (const auto holdGesture : m_activeHoldGestures) {
+        holdGesture->update(delta.count(), QPointF(), endedPrematurely);
         if (endedPrematurely)
             return;
     }
 }
 
-bool GestureRecognizer::pinchGestureUpdate(const qreal &scale, const qreal &angleDelta, const QPointF &delta, bool &endedPrematurely)
+std::optional<qreal> GestureRecognizer::holdGestureRemainingDelta() const
+{
+    std::optional<qreal> remaining;
+    for (const auto holdGesture : m_activeHoldGestures) {
+        const auto gestureRemaining = holdGesture->remainingDelta();
+        if (gestureRemaining && (!remaining || *gestureRemaining < *remaining))
+            remaining = gestureRemaining;
+    }
+    return remaining;
+}
+
+std::optional<std::chrono::microseconds> GestureRecognizer::holdGestureNextUpdate() const
+{
+    const auto remainingDelta = holdGestureRemainingDelta();
+    if (!remainingDelta)
+        return std::nullopt;
+
+    // Hold gesture deltas are in milliseconds
+    const std::chrono::duration<qreal, std::milli> interval(
+        std::clamp<qreal>(*remainingDelta, s_holdMinimumUpdateInterval.count(), std::numeric_limits<int>::max()));
+    return m_previousEventTime + std::chrono::ceil<std::chrono::microseconds>(interval);
+}
+
+bool GestureRecognizer::pinchGestureUpdate(const qreal &scale, const qreal &angleDelta, const QPointF &delta, const std::chrono::microseconds &time,
+                                           bool &endedPrematurely)
 {
     Q_UNUSED(delta)
 
+    const auto previousEventTime = std::exchange(m_previousEventTime, time);
     const auto pinchDelta = -(m_previousPinchScale - scale);
     m_previousPinchScale = scale;
     PinchDirection pinchDirection = scale < 1 ? PinchDirection::In : PinchDirection::Out;
@@ -85,77 +205,45 @@ bool GestureRecognizer::pinchGestureUpdate(const qreal &scale, const qreal &angl
         }
     }
 
+    const auto isRotate = m_pinchType == PinchType::Rotate;
+    const auto gestureDelta = isRotate ? angleDelta : pinchDelta;
+    const auto directionIndex = isRotate ? RotateGesture::directionIndex(rotateDirection) : PinchGesture::directionIndex(pinchDirection);
     if (m_isDeterminingSpeed) {
-        if (m_sampledInputEvents++ != m_inputEventsToSample) {
-            m_accumulatedAbsoluteSampledDelta += std::abs(m_pinchType == PinchType::Rotate ? angleDelta : pinchDelta);
-            return true;
-        }
-
-        const auto speedThreshold = m_pinchType == PinchType::Rotate
+        const auto speedThreshold = isRotate
             ? m_rotateFastThreshold
             : (scale < 1 ? m_pinchInFastThreshold : m_pinchOutFastThreshold);
-        if ((m_accumulatedAbsoluteSampledDelta / m_inputEventsToSample) >= speedThreshold)
-            m_speed = GestureSpeed::Fast;
-        else
-            m_speed = GestureSpeed::Slow;
-
-        m_isDeterminingSpeed = false;
-    }
-
-    if (m_pinchType == PinchType::Rotate) {
-        for (auto it = m_activeRotateGestures.begin(); it != m_activeRotateGestures.end();) {
-            const auto &gesture = *it;
-            if (!gesture->satisfiesUpdateConditions(m_speed, rotateDirection)) {
-                gesture->cancelled();
-                it = m_activeRotateGestures.erase(it);
-                continue;
+        sampleSpeed(std::abs(gestureDelta), previousEventTime, time, speedThreshold);
+        if (m_isDeterminingSpeed) {
+            bufferUpdate(gestureDelta, QPointF(), directionIndex);
+        } else {
+            if (isRotate) {
+                replayBufferedUpdates(m_activeRotateGestures, endedPrematurely);
+            } else {
+                replayBufferedUpdates(m_activePinchGestures, endedPrematurely);
             }
-
-            Q_EMIT gesture->updated(angleDelta, QPointF(), endedPrematurely);
             if (endedPrematurely) {
                 return true;
             }
-
-            it++;
         }
-    } else if (m_pinchType == PinchType::Pinch) {
-        for (auto it = m_activePinchGestures.begin(); it != m_activePinchGestures.end();) {
-            const auto &gesture = *it;
-            if (!gesture->satisfiesUpdateConditions(m_speed, pinchDirection)) {
-                gesture->cancelled();
-                it = m_activePinchGestures.erase(it);
-                continue;
-            }
-
-            Q_EMIT gesture->updated(pinchDelta, QPointF(), endedPrematurely);
-            if (endedPrematurely)
-                return true;
+    }
 
-            it++;
-        }
+    if (isRotate) {
+        updateGestures(m_activeRotateGestures, directionIndex, gestureDelta, QPointF(), endedPrematurely);
+    } else {
+        updateGestures(m_activePinchGestures, directionIndex, gestureDelta, QPointF(), endedPrematurely);
+    }
+    if (endedPrematurely) {
+        return true;
     }
 
     return !m_activePinchGestures.empty();
 }
 
-bool GestureRecognizer::swipeGestureUpdate(const QPointF &delta, bool &endedPrematurely)
+bool GestureRecognizer::swipeGestureUpdate(const QPointF &delta, const std::chrono::microseconds &time, bool &endedPrematurely)
 {
+    const auto previousEventTime = std::exchange(m_previousEventTime, time);
     m_currentSwipeDelta += delta;
 
-    if (m_isDeterminingSpeed) {
-        if (m_sampledInputEvents++ != m_inputEventsToSample) {
-            m_accumulatedAbsoluteSampledDelta += std::abs(delta.x()) + std::abs(delta.y());
-            return true;
-        }
-
-        if ((m_accumulatedAbsoluteSampledDelta / m_inputEventsToSample) >= m_swipeGestureFastThreshold)
-            m_speed = GestureSpeed::Fast;
-        else
-            m_speed = GestureSpeed::Slow;
-
-        m_isDeterminingSpeed = false;
-    }
-
     SwipeDirection direction; // Overall direction
     Axis swipeAxis;
 
@@ -186,43 +274,97 @@ bool GestureRecognizer::swipeGestureUpdate(const QPointF &delta, bool &endedPrem
         Q_UNREACHABLE();
     }
 
-    for (auto it = m_activeSwipeGestures.begin(); it != m_activeSwipeGestures.end();) {
-        const auto gesture = *it;
-        if (!gesture->satisfiesUpdateConditions(m_speed, direction)) {
-            gesture->cancelled();
-            it = m_activeSwipeGestures.erase(it);
-            continue;
+    const auto directionIndex = SwipeGesture::directionIndex(direction);
+    const auto axisDelta = swipeAxis == Axis::Vertical ? delta.y() : delta.x();
+    const auto deltaPointMultiplied = delta * m_deltaMultiplier;
+    if (m_isDeterminingSpeed) {
+        sampleSpeed(std::abs(delta.x()) + std::abs(delta.y()), previousEventTime, time, m_swipeGestureFastThreshold);
+        if (m_isDeterminingSpeed) {
+            bufferUpdate(axisDelta, deltaPointMultiplied, directionIndex);
+        } else {
+            replayBufferedUpdates(m_activeSwipeGestures, endedPrematurely);
+            if (endedPrematurely) {
+                return true;
+            }
         }
+    }
 
-        Q_EMIT gesture->updated(swipeAxis == Axis::Vertical ? delta.y() : delta.x(), delta * m_deltaMultiplier, endedPrematurely);
-        if (endedPrematurely)
-            return true;
-
-        it++;
+    updateGestures(m_activeSwipeGestures, directionIndex, axisDelta, deltaPointMultiplied, endedPrematurely);
+    if (endedPrematurely) {
+        return true;
     }
 
     return !m_activeSwipeGestures.empty();
 }
 
-void GestureRecognizer::holdGestureBegin(const uint8_t &fingerCount)
+void GestureRecognizer::sampleSpeed(const qreal &absoluteDelta, const std::chrono::microseconds &previousTime,
+                                    const std::chrono::microseconds &time, const qreal &fastThreshold)
+{
+    if (!m_speedSampleStart) {
+        // The delta of the first sampled update was accumulated since the previous event
+        m_speedSampleStart = previousTime;
+        m_kinematics.reset(previousTime);
+    }
+    m_kinematics.update(absoluteDelta, time);
+    m_speedFastThreshold = fastThreshold;
+
+    if (m_kinematics.velocity() > 0 && m_kinematics.velocity() >= fastThreshold) {
+        // Same estimate as determineSpeed, so that the outcome doesn't depend on when the speed is determined
+        m_speed = GestureSpeed::Fast;
+        m_isDeterminingSpeed = false;
+    } else if (time - *m_speedSampleStart >= std::chrono::milliseconds(m_speedSampleTime)
+               || m_bufferedUpdateCount == s_maxBufferedUpdates) {
+        determineSpeed();
+    }
+}
+
+void GestureRecognizer::determineSpeed()
+{
+    if (m_kinematics.velocity() > 0 && m_kinematics.velocity() >= m_speedFastThreshold)
+        m_speed = GestureSpeed::Fast;
+    else
+        m_speed = GestureSpeed::Slow;
+
+    m_isDeterminingSpeed = false;
+}
+
+void GestureRecognizer::bufferUpdate(const qreal &delta, const QPointF &deltaPointMultiplied, const uint8_t &directionIndex)
+{
+    // sampleSpeed determines the speed before the buffer overflows
+    m_bufferedUpdates[m_bufferedUpdateCount++] = {delta, deltaPointMultiplied, directionIndex};
+}
+
+void GestureRecognizer::holdGestureBegin(const uint8_t &fingerCount, const std::chrono::microseconds &time)
 {
     resetMembers();
+    m_previousEventTime = time;
     gestureBegin(fingerCount, m_activeHoldGestures);
 }
 
-void GestureRecognizer::holdGestureCancel()
+void GestureRecognizer::holdGestureCancel(const std::chrono::microseconds &time)
 {
+    if (!m_activeHoldGestures.empty()) {
+        // The gestures are being cancelled anyway
+        bool endedPrematurely = false;
+        holdGestureUpdate(time, endedPrematurely);
+    }
     gestureCancel(m_activeHoldGestures);
 }
 
-bool GestureRecognizer::holdGestureEnd()
+bool GestureRecognizer::holdGestureEnd(const std::chrono::microseconds &time)
 {
+    if (!m_activeHoldGestures.empty()) {
+        // The gestures are ending anyway
+        bool endedPrematurely = false;
+        holdGestureUpdate(time, endedPrematurely);
+    }
     return gestureEnd(m_activeHoldGestures);
 }
 
-void GestureRecognizer::swipeGestureBegin(const uint8_t &fingerCount)
+void GestureRecognizer::swipeGestureBegin(const uint8_t &fingerCount, const std::chrono::microseconds &time)
 {
     resetMembers();
+    m_previousEventTime = time;
     gestureBegin(fingerCount, m_activeSwipeGestures);
 }
 
@@ -233,12 +375,14 @@ void GestureRecognizer::swipeGestureCancel()
 
 bool GestureRecognizer::swipeGestureEnd()
 {
+    determineSpeedBeforeEnd(m_activeSwipeGestures);
     return gestureEnd(m_activeSwipeGestures);
 }
 
-void GestureRecognizer::pinchGestureBegin(const uint8_t &fingerCount)
+void GestureRecognizer::pinchGestureBegin(const uint8_t &fingerCount, const std::chrono::microseconds &time)
 {
     resetMembers();
+    m_previousEventTime = time;
     gestureBegin(fingerCount, m_activePinchGestures);
     gestureBegin(fingerCount, m_activeRotateGestures);
 }
@@ -251,30 +395,39 @@ void GestureRecognizer::pinchGestureCancel()
 
 bool GestureRecognizer::pinchGestureEnd()
 {
+    if (m_pinchType == PinchType::Rotate) {
+        determineSpeedBeforeEnd(m_activeRotateGestures);
+    } else if (m_pinchType == PinchType::Pinch) {
+        determineSpeedBeforeEnd(m_activePinchGestures);
+    }
     return gestureEnd(m_activePinchGestures) || gestureEnd(m_activeRotateGestures);
 }
 
 template<class TGesture>
-void GestureRecognizer::gestureBegin(const uint8_t &fingerCount, std::vector<std::shared_ptr<TGesture>> &activeGestures)
+void GestureRecognizer::gestureBegin(const uint8_t &fingerCount, ActiveGestures<TGesture> &activeGestures)
 {
-    if (!activeGestures.empty())
+    if (!activeGestures.empty() || fingerCount > s_maxFingerCount)
         return;
 
+    const auto &table = gestureIndex<TGesture>()[fingerCount];
+    const auto &gestures = table.gestures;
+    activeGestures.assign(table);
+
     auto hasModifiers = false;
-    for (const std::shared_ptr<Gesture> &gesture : m_gestures) {
-        std::shared_ptr<TGesture> castedGesture = std::dynamic_pointer_cast<TGesture>(gesture);
-        if (!castedGesture || !gesture->satisfiesBeginConditions(fingerCount))
+    for (size_t i = 0; i < gestures.size(); i++) {
+        const auto gesture = gestures[i];
+        if (!gesture->satisfiesBeginConditions(fingerCount))
             continue;
 
-        if (castedGesture->speed() != GestureSpeed::Any) {
+        if (gesture->speed() != GestureSpeed::Any) {
             m_isDeterminingSpeed = true;
         }
 
-        if (castedGesture->keyboardModifiers() && *castedGesture->keyboardModifiers() != Qt::KeyboardModifier::NoModifier) {
+        if (gesture->keyboardModifiers() && *gesture->keyboardModifiers() != Qt::KeyboardModifier::NoModifier) {
             hasModifiers = true;
         }
 
-        activeGestures.push_back(castedGesture);
+        activeGestures.insert(i);
     }
 
     if (hasModifiers) {
@@ -283,28 +436,94 @@ void GestureRecognizer::gestureBegin(const uint8_t &fingerCount, std::vector<std
 }
 
 template<class TGesture>
-bool GestureRecognizer::gestureEnd(std::vector<std::shared_ptr<TGesture>> &activeGestures)
+bool GestureRecognizer::gestureEnd(ActiveGestures<TGesture> &activeGestures)
 {
     bool hadActiveGestures = !activeGestures.empty();
-    for (const auto &gesture : activeGestures)
-        Q_EMIT gesture->ended();
+    for (const auto gesture : activeGestures)
+        gesture->end();
     activeGestures.clear();
 
     return hadActiveGestures;
 }
 
 template<class TGesture>
-void GestureRecognizer::gestureCancel(std::vector<std::shared_ptr<TGesture>> &activeGestures)
+void GestureRecognizer::gestureCancel(ActiveGestures<TGesture> &activeGestures)
 {
-    for (const auto &gesture : activeGestures)
-        Q_EMIT gesture->cancelled();
+    for (const auto gesture : activeGestures)
+        gesture->cancel();
     activeGestures.clear();
 }
 
+template<class TGesture>
+void GestureRecognizer::updateGestures(ActiveGestures<TGesture> &activeGestures, const uint8_t &directionIndex, const qreal &delta,
+                                       const QPointF &deltaPointMultiplied, bool &endedPrematurely)
+{
+    const auto cancel = [](TGesture *gesture) {
+        gesture->cancel();
+    };
+
+    if (m_isDeterminingSpeed) {
+        // Gestures that depend on the speed receive this update once it has been determined
+        activeGestures.retainAccepting((1u << updateKind(directionIndex, GestureSpeed::Slow)) | (1u << updateKind(directionIndex, GestureSpeed::Fast)),
+                                       cancel);
+        for (const auto gesture : activeGestures) {
+            if (gesture->speed() != GestureSpeed::Any)
+                continue;
+
+            gesture->update(delta, deltaPointMultiplied, endedPrematurely);
+            if (endedPrematurely)
+                return;
+        }
+        return;
+    }
+
+    activeGestures.retainAccepting(1u << updateKind(directionIndex, m_speed), cancel);
+    for (const auto gesture : activeGestures) {
+        gesture->update(delta, deltaPointMultiplied, endedPrematurely);
+        if (endedPrematurely)
+            return;
+    }
+}
+
+template<class TGesture>
+void GestureRecognizer::replayBufferedUpdates(ActiveGestures<TGesture> &activeGestures, bool &endedPrematurely)
+{
+    const auto cancel = [](TGesture *gesture) {
+        gesture->cancel();
+    };
+
+    for (size_t i = 0; i < m_bufferedUpdateCount && !endedPrematurely; i++) {
+        const auto &update = m_bufferedUpdates[i];
+        activeGestures.retainAccepting(1u << updateKind(update.directionIndex, m_speed), cancel);
+        for (const auto gesture : activeGestures) {
+            // Gestures that don't depend on the speed have already received this update
+            if (gesture->speed() == GestureSpeed::Any)
+                continue;
+
+            gesture->update(update.delta, update.deltaPointMultiplied, endedPrematurely);
+            if (endedPrematurely)
+                break;
+        }
+    }
+    m_bufferedUpdateCount = 0;
+}
+
+template<class TGesture>
+void GestureRecognizer::determineSpeedBeforeEnd(ActiveGestures<TGesture> &activeGestures)
+{
+    if (!m_isDeterminingSpeed || !m_bufferedUpdateCount)
+        return;
+
+    determineSpeed();
+    // The gesture is ending anyway
+    bool endedPrematurely = false;
+    replayBufferedUpdates(activeGestures, endedPrematurely);
+}
+
 void GestureRecognizer::resetMembers()
 {
-    m_accumulatedAbsoluteSampledDelta = 0;
-    m_sampledInputEvents = 0;
+    m_speedSampleStart = std::nullopt;
+    m_bufferedUpdateCount = 0;
     m_pinchType = PinchType::Unknown;
     m_accumulatedRotateDelta = 0;
     m_isDeterminingSpeed = false;
@@ -1,6 +1,8 @@
 #pragma once
 
+#include "gestureset.h"
 #include "holdgesture.h"
+#include "kinematics.h"
 #include "pinchgesture.h"
 #include "rotategesture.h"
 #include "swipegesture.h"
@@ -8,6 +10,9 @@
 #include <QObject>
 #include <QPointF>
 
+#include <array>
+#include <chrono>
+
 namespace libgestures
 {
 
@@ -33,17 +38,47 @@ public:
     GestureRecognizer() = default;
 
     /**
-     * Adds a gesture to the end of the gesture list.
-     * @remark This method doesn't prevent duplicate gestures from being added.
+     * Maximum amount of fingers gestures are indexed for. Begin events with more fingers don't activate any gestures.
+     */
+    static constexpr uint8_t s_maxFingerCount = 10;
+
+    /**
+     * Adds a gesture to the end of the gesture list and indexes it by type and finger count.
+     * @remark This method doesn't prevent duplicate gestures from being added. The finger range, direction and speed
+     * of the gesture must be set before it is registered.
      */
     void registerGesture(std::shared_ptr<Gesture> gesture);
 
     /**
-     * Removes all registered gestures.
+     * Cancels all active gestures and removes all registered gestures.
      */
     void unregisterGestures();
 
-    void setInputEventsToSample(const uint8_t &events);
+    /**
+     * @return All registered gestures in the order they were registered.
+     */
+    const std::vector<std::shared_ptr<Gesture>> &gestures() const;
+
+    /**
+     * @return Whether any gesture of the specified type is registered for the specified amount of fingers. Events that
+     * can't match any gesture don't need to be passed to the recognizer at all.
+     * @remark This is a lookup in the gesture index and doesn't take conditions into account.
+     */
+    bool hasGestures(const GestureType &type, const uint8_t &fingerCount) const;
+
+    /**
+     * @return Whether any gesture of any type is currently active.
+     */
+    bool hasActiveGestures() const;
+
+    /**
+     * @param time How long to sample updates for in milliseconds in order to determine the speed of the gesture, unless
+     * it can be determined earlier.
+     */
+    void setSpeedSampleTime(const uint32_t &time);
+    /**
+     * @param threshold Velocity in units per second at and above which gestures are considered fast.
+     */
     void setSwipeFastThreshold(const qreal &threshold);
     void setPinchInFastThreshold(const qreal &threshold);
     void setPinchOutFastThreshold(const qreal &threshold);
@@ -51,33 +86,56 @@ public:
 
     void setDeltaMultiplier(const qreal &multiplier);
 
+    /**
+     * @param timeout Time in milliseconds after the last scroll event at which the 2-finger swipe gesture scrolling is
+     * translated into ends.
+     */
+    void setScrollTimeout(const uint32_t &timeout);
+    const uint32_t &scrollTimeout() const;
+
     /**
      * @param fingerCount Amount of fingers currently on the input device.
+     * @param time Current time on Clock.
      */
-    void holdGestureBegin(const uint8_t &fingerCount);
-    // TODO move this back to GestureRecognizer
+    void holdGestureBegin(const uint8_t &fingerCount, const std::chrono::microseconds &time);
     /**
+     * Updates hold gestures with the milliseconds elapsed between the previous begin or update and the specified time.
+     * @param time Current time on Clock, not the elapsed time.
      * @param endedPrematurely Whether the gesture should end immediately before the fingers have been lifted. This
      * parameter is only handled in the KWin effect to continue blocking built-in gestures.
-     * @remark This method should be called every 1 millisecond.
+     * @remark This method doesn't need to be called periodically, only at holdGestureNextUpdate.
+     */
+    void holdGestureUpdate(const std::chrono::microseconds &time, bool &endedPrematurely);
+    /**
+     * @return Time on Clock at which the active hold gestures should be updated next, or std::nullopt if no update
+     * will ever have any effect. Updates are never scheduled less than s_holdMinimumUpdateInterval apart.
      */
-    void holdGestureUpdate(const qreal &delta, bool &endedPrematurely);
+    std::optional<std::chrono::microseconds> holdGestureNextUpdate() const;
     /**
+     * Updates the active hold gestures to the specified time and ends them. Hold gestures are only updated when an
+     * update can have an effect, which doesn't include the thresholds of end and cancel actions.
+     * @param time Current time on Clock.
      * @return Whether there were any active hold gestures before the end.
      */
-    bool holdGestureEnd();
-    void holdGestureCancel();
+    bool holdGestureEnd(const std::chrono::microseconds &time);
+    /**
+     * Updates the active hold gestures to the specified time and cancels them, see holdGestureEnd.
+     * @param time Current time on Clock.
+     */
+    void holdGestureCancel(const std::chrono::microseconds &time);
 
     /**
      * @param fingerCount Amount of fingers currently on the input device.
+     * @param time Timestamp of the event on the monotonic clock.
      */
-    void swipeGestureBegin(const uint8_t &fingerCount);
+    void swipeGestureBegin(const uint8_t &fingerCount, const std::chrono::microseconds &time);
     /**
+     * @param time Timestamp of the event on the monotonic clock.
      * @param endedPrematurely Whether the gesture should end immediately before the fingers have been lifted. This
      * parameter is only handled in the KWin effect to continue blocking built-in gestures.
      * @return Whether there are currently any active swipe gestures.
      */
-    bool swipeGestureUpdate(const QPointF &delta, bool &endedPrematurely);
+    bool swipeGestureUpdate(const QPointF &delta, const std::chrono::microseconds &time, bool &endedPrematurely);
     /**
      * @remark This method may be called before the fingers have been lifted if a gesture with a threshold has been
      * triggered.
@@ -88,14 +146,17 @@ public:
 
     /**
      * @param fingerCount Amount of fingers currently on the input device.
+     * @param time Timestamp of the event on the monotonic clock.
      */
-    void pinchGestureBegin(const uint8_t &fingerCount);
+    void pinchGestureBegin(const uint8_t &fingerCount, const std::chrono::microseconds &time);
     /**
+     * @param time Timestamp of the event on the monotonic clock.
      * @param endedPrematurely Whether the gesture should end immediately before the fingers have been lifted. This
      * parameter is only handled in the KWin effect to continue blocking built-in gestures.
      * @return Whether there are currently any active pinch gestures.
      */
-    bool pinchGestureUpdate(const qreal &scale, const qreal &angleDelta, const QPointF &delta, bool &endedPrematurely);
+    bool pinchGestureUpdate(const qreal &scale, const qreal &angleDelta, const QPointF &delta, const std::chrono::microseconds &time,
+                            bool &endedPrematurely);
     /**
      * @param resetHasTriggeredGesture Whether built-in gestures should be allowed to trigger. Should be @c false if
      * this method is called due to a gesture with a threshold triggering.
@@ -107,44 +168,145 @@ public:
     void pinchGestureCancel();
 
 private:
+    /**
+     * Used when every update can have an effect, for example when an update action without an interval is active.
+     */
+    static constexpr std::chrono::milliseconds s_holdMinimumUpdateInterval{5};
+
+    /**
+     * @return How many milliseconds need to elapse before an update can have any effect on the active hold gestures, 0
+     * if any update can, or std::nullopt if no update ever will.
+     */
+    std::optional<qreal> holdGestureRemainingDelta() const;
+
+    /**
+     * Registered gestures of a single type, bucketed by finger count. Each gesture is present in the bucket of every
+     * finger count within its range, in the order the gestures were registered. Gestures are owned by m_gestures.
+     */
+    template<class TGesture>
+    using GestureIndex = std::array<GestureTable<TGesture>, s_maxFingerCount + 1>;
+
+    /**
+     * Gestures of a single type that are currently active, as a subset of the index bucket of the current finger
+     * count. The capacity is reserved for the largest bucket of the type's index, so beginning a gesture never
+     * allocates.
+     */
+    template<class TGesture>
+    using ActiveGestures = GestureSet<TGesture>;
+
+    template<class TGesture>
+    void indexGesture(TGesture *gesture, GestureIndex<TGesture> &index, ActiveGestures<TGesture> &activeGestures);
+    template<class TGesture>
+    const GestureIndex<TGesture> &gestureIndex() const;
+
+    template<class TGesture>
+    void gestureBegin(const uint8_t &fingerCount, ActiveGestures<TGesture> &activeGestures);
+    template<class TGesture>
+    bool gestureEnd(ActiveGestures<TGesture> &activeGestures);
     template<class TGesture>
-    void gestureBegin(const uint8_t &fingerCount, std::vector<std::shared_ptr<TGesture>> &activeGestures);
+    void gestureCancel(ActiveGestures<TGesture> &activeGestures);
+
+    /**
+     * Cancels and removes all active gestures that don't satisfy update conditions for the current speed and the
+     * specified direction, and updates the remaining ones. While the speed is being determined, only gestures that
+     * don't depend on it are updated. They therefore take precedence over gestures that depend on the speed when
+     * ending prematurely, regardless of registration order.
+     * @param directionIndex Index of a single direction, see updateKind.
+     */
+    template<class TGesture>
+    void updateGestures(ActiveGestures<TGesture> &activeGestures, const uint8_t &directionIndex, const qreal &delta,
+                        const QPointF &deltaPointMultiplied, bool &endedPrematurely);
+
+    /**
+     * Adds the delta of an update to the speed samples and determines the speed: fast as soon as the estimated
+     * velocity reaches the threshold, otherwise when the sample time has elapsed or when no more updates can be
+     * buffered.
+     * @param previousTime Timestamp of the previous event.
+     */
+    void sampleSpeed(const qreal &absoluteDelta, const std::chrono::microseconds &previousTime, const std::chrono::microseconds &time,
+                     const qreal &fastThreshold);
+    /**
+     * Determines the speed from the velocity estimated from the samples.
+     */
+    void determineSpeed();
+    void bufferUpdate(const qreal &delta, const QPointF &deltaPointMultiplied, const uint8_t &directionIndex);
+    /**
+     * Passes updates buffered while the speed was being determined to gestures that depend on the speed.
+     */
     template<class TGesture>
-    bool gestureEnd(std::vector<std::shared_ptr<TGesture>> &activeGestures);
+    void replayBufferedUpdates(ActiveGestures<TGesture> &activeGestures, bool &endedPrematurely);
+    /**
+     * Determines the speed and replays buffered updates if the gesture ends before the speed could be determined.
+     */
     template<class TGesture>
-    void gestureCancel(std::vector<std::shared_ptr<TGesture>> &activeGestures);
+    void determineSpeedBeforeEnd(ActiveGestures<TGesture> &activeGestures);
 
     void resetMembers();
 
     std::vector<std::shared_ptr<Gesture>> m_gestures;
+    GestureIndex<HoldGesture> m_holdGestures;
+    GestureIndex<PinchGesture> m_pinchGestures;
+    GestureIndex<RotateGesture> m_rotateGestures;
+    GestureIndex<SwipeGesture> m_swipeGestures;
 
-    std::vector<std::shared_ptr<SwipeGesture>> m_activeSwipeGestures;
+    ActiveGestures<SwipeGesture> m_activeSwipeGestures;
     Axis m_currentSwipeAxis = Axis::None;
     QPointF m_currentSwipeDelta;
 
-    std::vector<std::shared_ptr<PinchGesture>> m_activePinchGestures;
+    ActiveGestures<PinchGesture> m_activePinchGestures;
     qreal m_previousPinchScale = 1;
 
-    std::vector<std::shared_ptr<RotateGesture>> m_activeRotateGestures;
+    ActiveGestures<RotateGesture> m_activeRotateGestures;
     PinchType m_pinchType = PinchType::Unknown;
     qreal m_accumulatedRotateDelta = 0;
 
-    std::vector<std::shared_ptr<HoldGesture>> m_activeHoldGestures;
+    ActiveGestures<HoldGesture> m_activeHoldGestures;
 
-    uint8_t m_inputEventsToSample = 3;
-    qreal m_swipeGestureFastThreshold = 20;
-    qreal m_pinchInFastThreshold = 0.04;
-    qreal m_pinchOutFastThreshold = 0.08;
-    qreal m_rotateFastThreshold = 5;
+    uint32_t m_speedSampleTime = 30;
+    qreal m_swipeGestureFastThreshold = 2000;
+    qreal m_pinchInFastThreshold = 4;
+    qreal m_pinchOutFastThreshold = 8;
+    qreal m_rotateFastThreshold = 500;
+
+    /**
+     * Timestamp of the last begin or update event, of hold gestures as well.
+     */
+    std::chrono::microseconds m_previousEventTime{};
 
     GestureSpeed m_speed = GestureSpeed::Any;
     bool m_isDeterminingSpeed = false;
-    uint8_t m_sampledInputEvents = 0;
-    qreal m_accumulatedAbsoluteSampledDelta = 0;
+    /**
+     * Timestamp the speed samples started at, std::nullopt if no update has been sampled yet.
+     */
+    std::optional<std::chrono::microseconds> m_speedSampleStart;
+    Kinematics m_kinematics;
+    /**
+     * Threshold the last sample was compared against.
+     */
+    qreal m_speedFastThreshold = 0;
+
+    /**
+     * An update received while the speed was being determined.
+     */
+    struct BufferedUpdate
+    {
+        qreal delta;
+        QPointF deltaPointMultiplied;
+        uint8_t directionIndex;
+    };
+    /**
+     * The speed of fast gestures is usually determined long before the buffer is full.
+     */
+    static constexpr size_t s_maxBufferedUpdates = 64;
+    std::array<BufferedUpdate, s_maxBufferedUpdates> m_bufferedUpdates;
+    size_t m_bufferedUpdateCount = 0;
 
     qreal m_deltaMultiplier = 1.0;
+    uint32_t m_scrollTimeout = 100;
 
+    friend class ConfigCache;
     friend struct YAML::convert<std::shared_ptr<GestureRecognizer>>;
+    friend class TestConfigCache;
     friend class TestGestureRecognizer;
 };
 
@@ -0,0 +1,220 @@
+#pragma once
+
+#include "gesture.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace libgestures
+{
+
+/**
+ * An ordered list of gestures (an index bucket), along with precomputed bitsets of the gestures that accept each
+ * update kind.
+ */
+template<class TGesture>
+struct GestureTable
+{
+    /**
+     * Appends the gesture and records the update kinds it accepts. The direction and speed of the gesture must not
+     * change afterwards.
+     */
+    void push_back(TGesture *gesture)
+    {
+        const auto index = gestures.size();
+        gestures.push_back(gesture);
+        for (uint8_t kind = 0; kind < s_updateKinds; kind++) {
+            auto &mask = acceptedUpdates[kind];
+            mask.resize(index / 64 + 1);
+            if (gesture->acceptedUpdates() & (1u << kind)) {
+                mask[index / 64] |= uint64_t(1) << (index % 64);
+            }
+        }
+    }
+
+    void clear()
+    {
+        gestures.clear();
+        for (auto &mask : acceptedUpdates) {
+            mask.clear();
+        }
+    }
+
+    std::vector<TGesture *> gestures;
+    /**
+     * For every update kind, a bitset of the gestures that accept updates of that kind.
+     */
+    std::array<std::vector<uint64_t>, s_updateKinds> acceptedUpdates;
+};
+
+/**
+ * A subset of a gesture table, stored as a dense bitset. Removing a gesture is O(1) and doesn't
+ * move other gestures, so it can be done while iterating.
+ */
+template<class TGesture>
+class GestureSet
+{
+public:
+    class Iterator
+    {
+    public:
+        Iterator(const GestureSet *set, const size_t &index)
+            : m_set(set)
+            , m_index(index)
+        {
+        }
+
+        TGesture *operator*() const
+        {
+            return m_set->m_table->gestures[m_index];
+        }
+
+        Iterator &operator++()
+        {
+            m_index = m_set->next(m_index + 1);
+            return *this;
+        }
+
+        bool operator==(const Iterator &other) const
+        {
+            return m_index == other.m_index;
+        }
+
+        /**
+         * @return Position of the gesture in the table.
+         */
+        const size_t &index() const
+        {
+            return m_index;
+        }
+
+    private:
+        const GestureSet *m_set;
+        size_t m_index;
+    };
+
+    /**
+     * Reserves memory for tables of up to @p size gestures, so that assign never allocates.
+     */
+    void reserve(const size_t &size)
+    {
+        m_words.reserve(wordCount(size));
+    }
+
+    /**
+     * Makes this an empty subset of @p table.
+     */
+    void assign(const GestureTable<TGesture> &table)
+    {
+        m_table = &table;
+        m_words.assign(wordCount(table.gestures.size()), 0);
+        m_size = 0;
+    }
+
+    void insert(const size_t &index)
+    {
+        auto &word = m_words[index / 64];
+        const auto bit = uint64_t(1) << (index % 64);
+        if (!(word & bit)) {
+            word |= bit;
+            m_size++;
+        }
+    }
+
+    void remove(const size_t &index)
+    {
+        auto &word = m_words[index / 64];
+        const auto bit = uint64_t(1) << (index % 64);
+        if (word & bit) {
+            word &= ~bit;
+            m_size--;
+        }
+    }
+
+    /**
+     * Removes all gestures that don't accept updates of any of the specified kinds, calling @p removed for each of
+     * them.
+     * @param updateKinds Bitmask of update kinds.
+     */
+    template<typename TCallback>
+    void retainAccepting(const uint32_t &updateKinds, TCallback &&removed)
+    {
+        m_size = 0;
+        for (size_t i = 0; i < m_words.size(); i++) {
+            uint64_t accepted = 0;
+            for (auto kinds = updateKinds; kinds; kinds &= kinds - 1) {
+                accepted |= m_table->acceptedUpdates[std::countr_zero(kinds)][i];
+            }
+
+            auto rejected = m_words[i] & ~accepted;
+            m_words[i] &= accepted;
+            m_size += std::popcount(m_words[i]);
+            for (; rejected; rejected &= rejected - 1) {
+                removed(m_table->gestures[i * 64 + std::countr_zero(rejected)]);
+            }
+        }
+    }
+
+    void clear()
+    {
+        std::fill(m_words.begin(), m_words.end(), 0);
+        m_size = 0;
+    }
+
+    bool empty() const
+    {
+        return m_size == 0;
+    }
+
+    const size_t &size() const
+    {
+        return m_size;
+    }
+
+    Iterator begin() const
+    {
+        return Iterator(this, next(0));
+    }
+
+    Iterator end() const
+    {
+        return Iterator(this, s_end);
+    }
+
+private:
+    static size_t wordCount(const size_t &size)
+    {
+        return (size + 63) / 64;
+    }
+
+    /**
+     * @return Index of the first gesture in the set at or after @p index, or s_end if there is none.
+     */
+    size_t next(const size_t &index) const
+    {
+        auto wordIndex = index / 64;
+        if (wordIndex >= m_words.size()) {
+            return s_end;
+        }
+
+        auto word = m_words[wordIndex] & (~uint64_t(0) << (index % 64));
+        while (!word) {
+            if (++wordIndex == m_words.size()) {
+                return s_end;
+            }
+            word = m_words[wordIndex];
+        }
+        return wordIndex * 64 + std::countr_zero(word);
+    }
+
+    static constexpr size_t s_end = SIZE_MAX;
+
+    const GestureTable<TGesture> *m_table = nullptr;
+    std::vector<uint64_t> m_words;
+    size_t m_size = 0;
+};
+
+}
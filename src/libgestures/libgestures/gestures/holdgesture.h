@@ -7,6 +7,11 @@ namespace libgestures
 
 class HoldGesture : public Gesture
 {
+public:
+    GestureType type() const override
+    {
+        return GestureType::Hold;
+    }
 };
 
 }
\ No newline at end of file
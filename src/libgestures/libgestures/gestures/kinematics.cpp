@@ -0,0 +1,47 @@
+#include "kinematics.h"
+
+#include <cmath>
+
+namespace libgestures
+{
+
+void Kinematics::setTimeConstant(const qreal &timeConstant)
+{
+    m_timeConstant = timeConstant;
+}
+
+void Kinematics::reset(const std::chrono::microseconds &time)
+{
+    m_previousTime = time;
+    m_pendingDelta = 0;
+    m_samples = 0;
+    m_velocity = 0;
+}
+
+void Kinematics::update(const qreal &delta, const std::chrono::microseconds &time)
+{
+    m_pendingDelta += delta;
+    const std::chrono::duration<qreal> elapsed = time - m_previousTime;
+    if (elapsed.count() <= 0)
+        return;
+
+    const auto velocity = m_pendingDelta / elapsed.count();
+    m_pendingDelta = 0;
+    m_previousTime = time;
+
+    if (m_samples++ == 0) {
+        m_velocity = velocity;
+        return;
+    }
+
+    // Irregularly spaced samples: the longer the gap, the more weight the new sample gets
+    const auto alpha = m_timeConstant > 0 ? 1 - std::exp(-elapsed.count() / m_timeConstant) : 1;
+    m_velocity += alpha * (velocity - m_velocity);
+}
+
+const qreal &Kinematics::velocity() const
+{
+    return m_velocity;
+}
+
+}
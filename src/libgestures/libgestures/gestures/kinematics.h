@@ -0,0 +1,55 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <chrono>
+
+namespace libgestures
+{
+
+/**
+ * Estimates the velocity of a gesture from the deltas and timestamps of its updates, using an exponentially weighted
+ * moving average. Since the weight of a sample depends on the time elapsed since the previous one rather than on the
+ * amount of samples, the estimate doesn't depend on the rate the input device sends events at.
+ *
+ * Updating the estimate is O(1) and doesn't allocate.
+ */
+class Kinematics
+{
+public:
+    /**
+     * @param timeConstant Time in seconds after which the weight of a sample has decayed to 1/e.
+     */
+    void setTimeConstant(const qreal &timeConstant);
+
+    /**
+     * Discards all samples.
+     * @param time Timestamp the delta of the first sample is accumulated from.
+     */
+    void reset(const std::chrono::microseconds &time);
+    /**
+     * @param delta Distance travelled since the previous sample, in any unit.
+     * @param time Timestamp of the sample on the monotonic clock.
+     * @remark Samples with the same timestamp as the previous one are combined with the next sample.
+     */
+    void update(const qreal &delta, const std::chrono::microseconds &time);
+
+    /**
+     * @return Velocity in units per second, 0 if there are no samples.
+     */
+    const qreal &velocity() const;
+
+private:
+    qreal m_timeConstant = 0.01;
+
+    std::chrono::microseconds m_previousTime{};
+    /**
+     * Delta of samples that had the same timestamp as the previous one.
+     */
+    qreal m_pendingDelta = 0;
+    uint32_t m_samples = 0;
+
+    qreal m_velocity = 0;
+};
+
+}
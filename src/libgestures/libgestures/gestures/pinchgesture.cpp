@@ -3,18 +3,31 @@
 namespace libgestures
 {
 
-bool PinchGesture::satisfiesUpdateConditions(const GestureSpeed &speed, const PinchDirection &direction) const
+/**
+ * @return Bitmask of the indices of single directions that satisfy the specified direction.
+ */
+static uint32_t acceptedDirections(const PinchDirection &direction)
 {
-    if (!Gesture::satisfiesUpdateConditions(speed)) {
-        return false;
+    if (direction == PinchDirection::Any) {
+        return (1u << PinchGesture::directionIndex(PinchDirection::In)) | (1u << PinchGesture::directionIndex(PinchDirection::Out));
     }
+    return 1u << PinchGesture::directionIndex(direction);
+}
 
-    return m_direction == PinchDirection::Any || m_direction == direction;
+PinchGesture::PinchGesture()
+{
+    setAcceptedDirections(acceptedDirections(m_direction));
+}
+
+bool PinchGesture::satisfiesUpdateConditions(const GestureSpeed &speed, const PinchDirection &direction) const
+{
+    return acceptedUpdates() & (1u << updateKind(directionIndex(direction), speed));
 }
 
 void PinchGesture::setDirection(const PinchDirection &direction)
 {
     m_direction = direction;
+    setAcceptedDirections(acceptedDirections(direction));
 }
 
 }
\ No newline at end of file
@@ -14,8 +14,27 @@ enum class PinchDirection {
 class PinchGesture : public Gesture
 {
 public:
+    PinchGesture();
+
+    GestureType type() const override
+    {
+        return GestureType::Pinch;
+    }
+
+    /**
+     * @param direction A single direction.
+     */
     bool satisfiesUpdateConditions(const GestureSpeed &speed, const PinchDirection &direction) const;
 
+    /**
+     * @param direction A single direction.
+     * @return Index of the direction used in update kinds.
+     */
+    static constexpr uint8_t directionIndex(const PinchDirection &direction)
+    {
+        return static_cast<uint8_t>(direction) - 1;
+    }
+
     PinchDirection direction() const
     {
         return m_direction;
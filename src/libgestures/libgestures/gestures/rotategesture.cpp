@@ -3,18 +3,31 @@
 namespace libgestures
 {
 
-bool RotateGesture::satisfiesUpdateConditions(const GestureSpeed &speed, const RotateDirection &direction) const
+/**
+ * @return Bitmask of the indices of single directions that satisfy the specified direction.
+ */
+static uint32_t acceptedDirections(const RotateDirection &direction)
 {
-    if (!Gesture::satisfiesUpdateConditions(speed)) {
-        return false;
+    if (direction == RotateDirection::Any) {
+        return (1u << RotateGesture::directionIndex(RotateDirection::Clockwise)) | (1u << RotateGesture::directionIndex(RotateDirection::Counterclockwise));
     }
+    return 1u << RotateGesture::directionIndex(direction);
+}
 
-    return m_direction == RotateDirection::Any || m_direction == direction;
+RotateGesture::RotateGesture()
+{
+    setAcceptedDirections(acceptedDirections(m_direction));
+}
+
+bool RotateGesture::satisfiesUpdateConditions(const GestureSpeed &speed, const RotateDirection &direction) const
+{
+    return acceptedUpdates() & (1u << updateKind(directionIndex(direction), speed));
 }
 
 void RotateGesture::setDirection(const RotateDirection &direction)
 {
     m_direction = direction;
+    setAcceptedDirections(acceptedDirections(direction));
 }
 
 }
\ No newline at end of file
@@ -14,8 +14,27 @@ enum class RotateDirection {
 class RotateGesture : public Gesture
 {
 public:
+    RotateGesture();
+
+    GestureType type() const override
+    {
+        return GestureType::Rotate;
+    }
+
+    /**
+     * @param direction A single direction.
+     */
     bool satisfiesUpdateConditions(const GestureSpeed &speed, const RotateDirection &direction) const;
 
+    /**
+     * @param direction A single direction.
+     * @return Index of the direction used in update kinds.
+     */
+    static constexpr uint8_t directionIndex(const RotateDirection &direction)
+    {
+        return static_cast<uint8_t>(direction) - 1;
+    }
+
     RotateDirection direction() const
     {
         return m_direction;
@@ -3,20 +3,41 @@
 namespace libgestures
 {
 
-bool SwipeGesture::satisfiesUpdateConditions(const GestureSpeed &speed, const SwipeDirection &direction) const
+/**
+ * @return Bitmask of the indices of single directions that satisfy the specified direction.
+ */
+static uint32_t acceptedDirections(const SwipeDirection &direction)
 {
-    if (!Gesture::satisfiesUpdateConditions(speed)) {
-        return false;
+    const auto bit = [](const SwipeDirection &singleDirection) {
+        return 1u << SwipeGesture::directionIndex(singleDirection);
+    };
+
+    switch (direction) {
+    case SwipeDirection::Any:
+        return bit(SwipeDirection::Left) | bit(SwipeDirection::Right) | bit(SwipeDirection::Down) | bit(SwipeDirection::Up);
+    case SwipeDirection::LeftRight:
+        return bit(SwipeDirection::Left) | bit(SwipeDirection::Right);
+    case SwipeDirection::UpDown:
+        return bit(SwipeDirection::Up) | bit(SwipeDirection::Down);
+    default:
+        return bit(direction);
     }
+}
+
+SwipeGesture::SwipeGesture()
+{
+    setAcceptedDirections(acceptedDirections(m_direction));
+}
 
-    return m_direction == SwipeDirection::Any || m_direction == direction
-        || (m_direction == SwipeDirection::LeftRight && (direction == SwipeDirection::Left || direction == SwipeDirection::Right))
-        || (m_direction == SwipeDirection::UpDown && (direction == SwipeDirection::Up || direction == SwipeDirection::Down));
+bool SwipeGesture::satisfiesUpdateConditions(const GestureSpeed &speed, const SwipeDirection &direction) const
+{
+    return acceptedUpdates() & (1u << updateKind(directionIndex(direction), speed));
 }
 
 void SwipeGesture::setDirection(const libgestures::SwipeDirection &direction)
 {
     m_direction = direction;
+    setAcceptedDirections(acceptedDirections(direction));
 }
 
 }
\ No newline at end of file
@@ -18,8 +18,27 @@ enum class SwipeDirection {
 class SwipeGesture : public Gesture
 {
 public:
+    SwipeGesture();
+
+    GestureType type() const override
+    {
+        return GestureType::Swipe;
+    }
+
+    /**
+     * @param direction A single direction.
+     */
     bool satisfiesUpdateConditions(const GestureSpeed &speed, const SwipeDirection &direction) const;
 
+    /**
+     * @param direction A single direction.
+     * @return Index of the direction used in update kinds.
+     */
+    static constexpr uint8_t directionIndex(const SwipeDirection &direction)
+    {
+        return static_cast<uint8_t>(direction) - 1;
+    }
+
     SwipeDirection direction() const
     {
         return m_direction;
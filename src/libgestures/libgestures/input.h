@@ -34,6 +34,13 @@ public:
     virtual void mouseMoveAbsolute(const QPointF &pos) { };
     virtual void mouseMoveRelative(const QPointF &pos) { };
 
+    /**
+     * Groups all input sent until the matching endBatch call, so that it is processed under a single timestamp and
+     * pointer frame. Batches may be nested, in which case the input is processed when the outermost one ends.
+     */
+    virtual void beginBatch() { };
+    virtual void endBatch() { };
+
     static Input *implementation()
     {
         return s_implementation.get();
@@ -44,4 +51,27 @@ private:
     static std::unique_ptr<Input> s_implementation;
 };
 
+/**
+ * Groups input sent during the lifetime of the object into a batch, see Input::beginBatch.
+ */
+class InputBatch
+{
+public:
+    InputBatch()
+        : m_input(Input::implementation())
+    {
+        m_input->beginBatch();
+    }
+    ~InputBatch()
+    {
+        m_input->endBatch();
+    }
+
+    InputBatch(const InputBatch &) = delete;
+    InputBatch &operator=(const InputBatch &) = delete;
+
+private:
+    Input *m_input;
+};
+
 }
\ No newline at end of file
@@ -0,0 +1,53 @@
+#include "latencyhistogram.h"
+
+#include <bit>
+#include <cmath>
+
+namespace libgestures
+{
+
+void LatencyHistogram::record(const std::chrono::microseconds &latency)
+{
+    const auto microseconds = std::max<int64_t>(latency.count(), 0);
+    const auto bucket = std::min<size_t>(std::bit_width(static_cast<uint64_t>(microseconds)), s_bucketCount - 1);
+    m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    m_count.fetch_add(1, std::memory_order_relaxed);
+
+    auto maximum = m_maximum.load(std::memory_order_relaxed);
+    while (microseconds > maximum && !m_maximum.compare_exchange_weak(maximum, microseconds, std::memory_order_relaxed)) {
+    }
+}
+
+void LatencyHistogram::reset()
+{
+    for (auto &bucket : m_buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    m_count.store(0, std::memory_order_relaxed);
+    m_maximum.store(0, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::count() const
+{
+    return m_count.load(std::memory_order_relaxed);
+}
+
+std::chrono::microseconds LatencyHistogram::maximum() const
+{
+    return std::chrono::microseconds(m_maximum.load(std::memory_order_relaxed));
+}
+
+std::chrono::microseconds LatencyHistogram::percentile(const qreal &percentile) const
+{
+    const auto target = static_cast<uint64_t>(std::ceil(count() * percentile / 100));
+    uint64_t accumulated = 0;
+    for (size_t i = 0; i < s_bucketCount; i++) {
+        accumulated += m_buckets[i].load(std::memory_order_relaxed);
+        if (accumulated > 0 && accumulated >= target) {
+            return std::chrono::microseconds(1ll << i);
+        }
+    }
+    return maximum();
+}
+
+}
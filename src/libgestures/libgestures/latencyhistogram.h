@@ -0,0 +1,40 @@
+#pragma once
+
+#include <QtGlobal>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+
+namespace libgestures
+{
+
+/**
+ * Lock-free histogram of latencies with power-of-two microsecond buckets. Latencies can be recorded from any thread.
+ */
+class LatencyHistogram
+{
+public:
+    static constexpr size_t s_bucketCount = 32;
+
+    void record(const std::chrono::microseconds &latency);
+    void reset();
+
+    uint64_t count() const;
+    std::chrono::microseconds maximum() const;
+    /**
+     * @param percentile From 0 to 100.
+     * @return Upper bound of the bucket the percentile falls into, or 0 if nothing has been recorded.
+     */
+    std::chrono::microseconds percentile(const qreal &percentile) const;
+
+private:
+    /**
+     * Bucket n contains latencies lower than 2^n microseconds and not lower than 2^(n-1) microseconds.
+     */
+    std::array<std::atomic<uint64_t>, s_bucketCount> m_buckets{};
+    std::atomic<uint64_t> m_count = 0;
+    std::atomic<int64_t> m_maximum = 0;
+};
+
+}
@@ -0,0 +1,63 @@
+#include "scheduler.h"
+
+#include "clock.h"
+
+namespace libgestures
+{
+
+Scheduler::TaskId Scheduler::addTask(std::function<void()> callback)
+{
+    m_tasks.push_back({std::move(callback), std::nullopt});
+    return m_tasks.size() - 1;
+}
+
+void Scheduler::schedule(const TaskId &task, const std::chrono::microseconds &deadline)
+{
+    m_tasks[task].deadline = deadline;
+    if (!m_armedDeadline || deadline < *m_armedDeadline) {
+        m_armedDeadline = deadline;
+        armTimer(deadline);
+    }
+}
+
+void Scheduler::cancel(const TaskId &task)
+{
+    // The timer is left armed, run handles it firing without any task being due
+    m_tasks[task].deadline = std::nullopt;
+}
+
+bool Scheduler::isScheduled(const TaskId &task) const
+{
+    return m_tasks[task].deadline.has_value();
+}
+
+std::optional<std::chrono::microseconds> Scheduler::nextDeadline() const
+{
+    std::optional<std::chrono::microseconds> deadline;
+    for (const auto &task : m_tasks) {
+        if (task.deadline && (!deadline || *task.deadline < *deadline))
+            deadline = task.deadline;
+    }
+    return deadline;
+}
+
+void Scheduler::run()
+{
+    m_armedDeadline = std::nullopt;
+    const auto now = Clock::implementation()->now();
+    for (auto &task : m_tasks) {
+        if (!task.deadline || *task.deadline > now)
+            continue;
+
+        task.deadline = std::nullopt;
+        task.callback();
+    }
+
+    const auto earliestDeadline = nextDeadline();
+    if (earliestDeadline && (!m_armedDeadline || *earliestDeadline < *m_armedDeadline)) {
+        m_armedDeadline = earliestDeadline;
+        armTimer(*earliestDeadline);
+    }
+}
+
+}
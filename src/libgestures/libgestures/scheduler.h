@@ -0,0 +1,73 @@
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <optional>
+#include <vector>
+
+namespace libgestures
+{
+
+/**
+ * Runs deadline-based work using a single timer, which is armed for the earliest deadline.
+ *
+ * The timer is re-armed lazily: moving a deadline to a later time doesn't re-arm it. When the timer fires before any
+ * deadline has passed, it is re-armed for the earliest one. This keeps the amount of timer syscalls low when a deadline
+ * is moved by every input event.
+ *
+ * The base implementation doesn't have a timer, run must be called manually.
+ */
+class Scheduler
+{
+public:
+    using TaskId = size_t;
+
+    Scheduler() = default;
+    virtual ~Scheduler() = default;
+
+    /**
+     * Tasks are expected to be added once and rescheduled many times, so adding them may allocate but scheduling them
+     * doesn't.
+     * @return The ID of the task, used to schedule it.
+     * @remark Must not be called from a task.
+     */
+    TaskId addTask(std::function<void()> callback);
+
+    /**
+     * Schedules the task to run at the specified time on Clock, replacing its previous deadline.
+     */
+    void schedule(const TaskId &task, const std::chrono::microseconds &deadline);
+    void cancel(const TaskId &task);
+    bool isScheduled(const TaskId &task) const;
+    /**
+     * @return The earliest deadline of all scheduled tasks, std::nullopt if no task is scheduled.
+     */
+    std::optional<std::chrono::microseconds> nextDeadline() const;
+
+    /**
+     * Runs all tasks whose deadline has passed and arms the timer for the earliest remaining deadline. Tasks are
+     * unscheduled before they run and may schedule themselves again.
+     */
+    void run();
+
+protected:
+    /**
+     * Arms the timer to call run at the specified time on Clock, replacing the previous time.
+     */
+    virtual void armTimer(const std::chrono::microseconds &deadline) { };
+
+private:
+    struct Task
+    {
+        std::function<void()> callback;
+        std::optional<std::chrono::microseconds> deadline;
+    };
+    std::vector<Task> m_tasks;
+
+    /**
+     * The time the timer is armed for, std::nullopt if it isn't armed.
+     */
+    std::optional<std::chrono::microseconds> m_armedDeadline;
+};
+
+}
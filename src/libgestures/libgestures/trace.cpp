@@ -0,0 +1,142 @@
+#include "trace.h"
+
+#include <QFile>
+
+#include <cerrno>
+
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace libgestures
+{
+
+/**
+ * How often the worker thread writes recorded events to the file.
+ */
+static constexpr std::chrono::milliseconds s_flushInterval(250);
+
+std::optional<std::vector<TraceRecord>> readTrace(const QString &path)
+{
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly)) {
+        return std::nullopt;
+    }
+
+    quint32 header[2];
+    if (file.read(reinterpret_cast<char *>(header), sizeof(header)) != sizeof(header) || header[0] != s_traceMagic
+        || header[1] != s_traceVersion) {
+        return std::nullopt;
+    }
+
+    // Incomplete trailing records are the result of an interrupted write and are ignored
+    std::vector<TraceRecord> records((file.size() - sizeof(header)) / sizeof(TraceRecord));
+    const auto size = static_cast<qint64>(records.size() * sizeof(TraceRecord));
+    if (file.read(reinterpret_cast<char *>(records.data()), size) != size) {
+        return std::nullopt;
+    }
+    return records;
+}
+
+TraceRecorder::TraceRecorder(const QString &path)
+    : m_path(path)
+    , m_fd(open(path.toLocal8Bit().constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644))
+{
+    if (m_fd == -1) {
+        return;
+    }
+
+    const quint32 header[2] = {s_traceMagic, s_traceVersion};
+    if (write(m_fd, header, sizeof(header)) != sizeof(header)) {
+        close(m_fd);
+        m_fd = -1;
+        return;
+    }
+    m_thread = std::thread(&TraceRecorder::run, this);
+}
+
+TraceRecorder::~TraceRecorder()
+{
+    {
+        std::lock_guard lock(m_mutex);
+        m_stopping = true;
+    }
+    m_stopCondition.notify_one();
+
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+    if (m_fd != -1) {
+        close(m_fd);
+    }
+}
+
+bool TraceRecorder::isOpen() const
+{
+    return m_fd != -1;
+}
+
+const QString &TraceRecorder::path() const
+{
+    return m_path;
+}
+
+void TraceRecorder::record(const TraceRecord &record)
+{
+    const auto writeIndex = m_writeIndex.load(std::memory_order_relaxed);
+    if (writeIndex - m_readIndex.load(std::memory_order_acquire) == s_capacity) {
+        m_dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    m_buffer[writeIndex & (s_capacity - 1)] = record;
+    m_writeIndex.store(writeIndex + 1, std::memory_order_release);
+}
+
+uint64_t TraceRecorder::dropped() const
+{
+    return m_dropped.load(std::memory_order_relaxed);
+}
+
+void TraceRecorder::run()
+{
+    std::unique_lock lock(m_mutex);
+    while (!m_stopping) {
+        // The recording thread never notifies, so that recording stays cheap
+        m_stopCondition.wait_for(lock, s_flushInterval);
+        lock.unlock();
+        flush();
+        lock.lock();
+    }
+
+    lock.unlock();
+    flush();
+}
+
+void TraceRecorder::flush()
+{
+    auto readIndex = m_readIndex.load(std::memory_order_relaxed);
+    const auto writeIndex = m_writeIndex.load(std::memory_order_acquire);
+    while (readIndex != writeIndex) {
+        // At most two contiguous regions if the records wrap around the end of the buffer
+        const auto start = readIndex & (s_capacity - 1);
+        const auto count = std::min(writeIndex - readIndex, s_capacity - start);
+        const auto size = count * sizeof(TraceRecord);
+        const auto data = reinterpret_cast<const char *>(&m_buffer[start]);
+        for (size_t written = 0; written < size;) {
+            const auto result = write(m_fd, data + written, size - written);
+            if (result == -1) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                // Discard the records rather than blocking the recording thread forever
+                break;
+            }
+            written += result;
+        }
+
+        readIndex += count;
+        m_readIndex.store(readIndex, std::memory_order_release);
+    }
+}
+
+}
@@ -0,0 +1,131 @@
+#pragma once
+
+#include <QString>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+namespace libgestures
+{
+
+enum class TraceEventType : uint8_t {
+    HoldBegin,
+    HoldUpdate,
+    HoldEnd,
+    HoldCancel,
+    PinchBegin,
+    PinchUpdate,
+    PinchEnd,
+    PinchCancel,
+    SwipeBegin,
+    SwipeUpdate,
+    SwipeEnd,
+    SwipeCancel
+};
+
+/**
+ * A single event passed to the gesture recognizer, in the binary input trace format. Touchpad scrolling is recorded as
+ * the 2-finger swipe events it is translated into.
+ *
+ * A trace file consists of the magic number and version (both quint32), followed by records. Integers and floats are
+ * in native byte order.
+ */
+struct TraceRecord
+{
+    /**
+     * Timestamp of the event in microseconds on the monotonic clock.
+     */
+    uint64_t time = 0;
+    float deltaX = 0;
+    float deltaY = 0;
+    float scale = 1;
+    float angleDelta = 0;
+    TraceEventType type = TraceEventType::HoldBegin;
+    /**
+     * Only set for begin events.
+     */
+    uint8_t fingers = 0;
+    uint8_t reserved[6]{};
+};
+static_assert(sizeof(TraceRecord) == 32);
+
+static constexpr quint32 s_traceMagic = 0x4B574754; // KWGT
+static constexpr quint32 s_traceVersion = 1;
+
+/**
+ * @return The records of the trace file, or std::nullopt if the file couldn't be read or is not a trace of this
+ * version.
+ */
+std::optional<std::vector<TraceRecord>> readTrace(const QString &path);
+
+/**
+ * Writes records to a trace file. Records are added to a ring buffer and written in batches by a worker thread, so that
+ * recording doesn't block the thread handling input.
+ */
+class TraceRecorder
+{
+public:
+    /**
+     * Truncates the file and starts the worker thread.
+     */
+    explicit TraceRecorder(const QString &path);
+    /**
+     * Writes all remaining records and stops the worker thread.
+     */
+    ~TraceRecorder();
+
+    /**
+     * @return Whether the file was opened successfully. Records are discarded otherwise.
+     */
+    bool isOpen() const;
+    const QString &path() const;
+
+    /**
+     * Adds the record to the ring buffer. Must always be called from the same thread. Doesn't allocate or lock.
+     * @remark If the buffer is full, the record is dropped.
+     */
+    void record(const TraceRecord &record);
+
+    /**
+     * @return Amount of records dropped because the buffer was full.
+     */
+    uint64_t dropped() const;
+
+private:
+    void run();
+
+    /**
+     * Writes all records added so far. Called from the worker thread.
+     */
+    void flush();
+
+    const QString m_path;
+    int m_fd = -1;
+
+    /**
+     * Must be a power of two. 256 KiB, which is about 30 seconds of swipe events on a 240 Hz touchpad.
+     */
+    static constexpr size_t s_capacity = 8192;
+    std::unique_ptr<TraceRecord[]> m_buffer = std::make_unique<TraceRecord[]>(s_capacity);
+    /**
+     * Index of the next record to write to the file. Only modified by the worker thread.
+     */
+    alignas(64) std::atomic<size_t> m_readIndex = 0;
+    /**
+     * Index of the next record to add. Only modified by the recording thread.
+     */
+    alignas(64) std::atomic<size_t> m_writeIndex = 0;
+    std::atomic<uint64_t> m_dropped = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_stopCondition;
+    bool m_stopping = false;
+    std::thread m_thread;
+};
+
+}
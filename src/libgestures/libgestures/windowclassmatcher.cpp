@@ -0,0 +1,113 @@
+#include "windowclassmatcher.h"
+
+#include <algorithm>
+
+namespace libgestures
+{
+
+std::mutex WindowClassMatcher::s_registryMutex;
+std::map<std::pair<QString, int>, std::weak_ptr<const WindowClassMatcher>> WindowClassMatcher::s_registry;
+static constexpr size_t s_minimumRegistryPruneSize = 64;
+size_t WindowClassMatcher::s_registryPruneSize = s_minimumRegistryPruneSize;
+
+static const QString s_regexMetacharacters = QStringLiteral("\\^$.|?*+()[]{}");
+
+WindowClassMatcher::WindowClassMatcher(const QRegularExpression &regex)
+    : m_regex(regex)
+{
+    if (m_regex.patternOptions() == QRegularExpression::NoPatternOption) {
+        auto literal = m_regex.pattern();
+        const bool anchoredStart = literal.startsWith('^');
+        const bool anchoredEnd = literal.endsWith('$') && !literal.endsWith(QStringLiteral("\\$"));
+        if (anchoredStart) {
+            literal.remove(0, 1);
+        }
+        if (anchoredEnd && !literal.isEmpty()) {
+            literal.chop(1);
+        }
+
+        if (std::none_of(literal.cbegin(), literal.cend(), [](const QChar &c) {
+                return s_regexMetacharacters.contains(c);
+            })) {
+            m_literal = literal;
+            if (anchoredStart && anchoredEnd) {
+                m_literalMode = LiteralMode::Equals;
+            } else if (anchoredStart) {
+                m_literalMode = LiteralMode::StartsWith;
+            } else if (anchoredEnd) {
+                m_literalMode = LiteralMode::EndsWith;
+            } else {
+                m_literalMode = LiteralMode::Contains;
+            }
+            return;
+        }
+    }
+
+    // Compile (and JIT) now instead of on the first gesture
+    m_regex.optimize();
+}
+
+std::shared_ptr<const WindowClassMatcher> WindowClassMatcher::get(const QRegularExpression &regex)
+{
+    const std::lock_guard lock(s_registryMutex);
+    auto &entry = s_registry[{regex.pattern(), regex.patternOptions().toInt()}];
+    if (auto matcher = entry.lock()) {
+        return matcher;
+    }
+
+    auto matcher = std::make_shared<const WindowClassMatcher>(regex);
+    entry = matcher;
+
+    if (s_registry.size() >= s_registryPruneSize) {
+        // Drop entries of patterns that are no longer used by any condition
+        std::erase_if(s_registry, [](const auto &pair) {
+            return pair.second.expired();
+        });
+        s_registryPruneSize = std::max(s_registry.size() * 2, s_minimumRegistryPruneSize);
+    }
+    return matcher;
+}
+
+bool WindowClassMatcher::matches(const WindowInfo &window) const
+{
+    const auto resourceClass = window.resourceClass();
+    const auto resourceName = window.resourceName();
+    if (m_hasLastResult && m_lastResourceClass == resourceClass && m_lastResourceName == resourceName) {
+        return m_lastResult;
+    }
+
+    m_lastResult = matches(resourceClass) || matches(resourceName);
+    m_lastResourceClass = resourceClass;
+    m_lastResourceName = resourceName;
+    m_hasLastResult = true;
+    return m_lastResult;
+}
+
+bool WindowClassMatcher::matches(const QString &s) const
+{
+    switch (m_literalMode) {
+    case LiteralMode::Contains:
+        return s.contains(m_literal);
+    case LiteralMode::Equals:
+        return s == m_literal;
+    case LiteralMode::StartsWith:
+        return s.startsWith(m_literal);
+    case LiteralMode::EndsWith:
+        return s.endsWith(m_literal);
+    case LiteralMode::None:
+        break;
+    }
+    return m_regex.match(s).hasMatch();
+}
+
+QString WindowClassMatcher::pattern() const
+{
+    return m_regex.pattern();
+}
+
+QRegularExpression::PatternOptions WindowClassMatcher::patternOptions() const
+{
+    return m_regex.patternOptions();
+}
+
+}
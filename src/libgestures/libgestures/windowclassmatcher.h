@@ -0,0 +1,73 @@
+#pragma once
+
+#include "windowinfoprovider.h"
+
+#include <QRegularExpression>
+
+#include <map>
+#include <mutex>
+
+namespace libgestures
+{
+
+/**
+ * Matches a window's resource class and resource name against a pattern. Instances are shared between all
+ * conditions with an identical pattern, and the result for the last matched window is memoized.
+ */
+class WindowClassMatcher
+{
+public:
+    /**
+     * Use get() instead, so that identical patterns share one instance.
+     */
+    explicit WindowClassMatcher(const QRegularExpression &regex);
+
+    /**
+     * @return A matcher for the specified regular expression. Identical expressions return the same instance as long as
+     * it is referenced somewhere.
+     */
+    static std::shared_ptr<const WindowClassMatcher> get(const QRegularExpression &regex);
+
+    /**
+     * @return Whether the resource class or resource name of the window matches the pattern.
+     * @remark Not thread-safe.
+     */
+    bool matches(const WindowInfo &window) const;
+
+    QString pattern() const;
+    QRegularExpression::PatternOptions patternOptions() const;
+
+private:
+    /**
+     * Patterns that only consist of literal characters, optionally anchored with ^ and/or $, are matched without the
+     * regex engine.
+     */
+    enum class LiteralMode {
+        None,
+        Contains,
+        Equals,
+        StartsWith,
+        EndsWith
+    };
+
+    bool matches(const QString &s) const;
+
+    QRegularExpression m_regex;
+    LiteralMode m_literalMode = LiteralMode::None;
+    QString m_literal;
+
+    mutable QString m_lastResourceClass;
+    mutable QString m_lastResourceName;
+    mutable bool m_lastResult = false;
+    mutable bool m_hasLastResult = false;
+
+    static std::mutex s_registryMutex;
+    static std::map<std::pair<QString, int>, std::weak_ptr<const WindowClassMatcher>> s_registry;
+    /**
+     * Size of the registry at which entries of patterns that are no longer used are removed. Doubled after every
+     * prune, so that inserting is amortized O(log n) even when loading many conditions.
+     */
+    static size_t s_registryPruneSize;
+};
+
+}
@@ -13,6 +13,23 @@ WindowInfo::WindowInfo(QString title, QString resourceClass, QString resourceNam
 {
 }
 
+const std::optional<const WindowInfo> &WindowInfoProvider::cachedActiveWindow() const
+{
+    if (!m_activeWindowValid) {
+        m_activeWindow.reset();
+        if (auto window = activeWindow()) {
+            m_activeWindow.emplace(*window);
+        }
+        m_activeWindowValid = true;
+    }
+    return m_activeWindow;
+}
+
+void WindowInfoProvider::invalidateActiveWindow()
+{
+    m_activeWindowValid = false;
+}
+
 std::unique_ptr<WindowInfoProvider> WindowInfoProvider::s_implementation = std::make_unique<WindowInfoProvider>();
 void WindowInfoProvider::setImplementation(WindowInfoProvider *implementation)
 {
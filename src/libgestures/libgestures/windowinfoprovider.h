@@ -63,6 +63,18 @@ public:
         return std::nullopt;
     };
 
+    /**
+     * @return The cached result of activeWindow(). The cache is filled on first access after being invalidated.
+     * @remark Implementations must call invalidateActiveWindow() whenever any of the information returned by
+     * activeWindow() may have changed.
+     */
+    const std::optional<const WindowInfo> &cachedActiveWindow() const;
+
+    /**
+     * Causes the next cachedActiveWindow() call to query activeWindow() again.
+     */
+    void invalidateActiveWindow();
+
     static WindowInfoProvider *implementation()
     {
         return s_implementation.get();
@@ -70,6 +82,9 @@ public:
     static void setImplementation(WindowInfoProvider *implementation);
 
 private:
+    mutable std::optional<const WindowInfo> m_activeWindow;
+    mutable bool m_activeWindowValid = false;
+
     static std::unique_ptr<WindowInfoProvider> s_implementation;
 };
 
@@ -3,6 +3,7 @@
 #include "libgestures/actions/command.h"
 #include "libgestures/actions/input.h"
 #include "libgestures/actions/plasmaglobalshortcut.h"
+#include "libgestures/config.h"
 #include "libgestures/gestures/gesturerecognizer.h"
 
 #include <QRegularExpression>
@@ -702,6 +703,7 @@ struct convert<std::shared_ptr<libgestures::GestureAction>>
         if (node["command"].IsDefined()) {
             auto commandAction = new libgestures::CommandGestureAction();
             commandAction->setCommand(node["command"].as<QString>());
+            commandAction->setCoalescing(node["coalesce"].as<libgestures::CommandCoalescing>(libgestures::CommandCoalescing::None));
             action.reset(commandAction);
         } else if (node["input"].IsDefined()) {
             auto inputAction = new libgestures::InputGestureAction;
@@ -758,6 +760,16 @@ template<>
 struct convert<std::shared_ptr<libgestures::GestureRecognizer>>
 {
     static bool decode(const Node &node, std::shared_ptr<libgestures::GestureRecognizer> &gestureRecognizer)
+    {
+        return decode(node, gestureRecognizer, nullptr);
+    }
+
+    /**
+     * @param previous Recognizer of the previously loaded configuration. Its gestures are reused if their nodes
+     * haven't changed. May be nullptr.
+     */
+    static bool decode(const Node &node, std::shared_ptr<libgestures::GestureRecognizer> &gestureRecognizer,
+                       const libgestures::GestureRecognizer *previous)
     {
         const auto gesturesNode = node["gestures"];
         if (!gesturesNode.IsDefined()) {
@@ -765,29 +777,75 @@ struct convert<std::shared_ptr<libgestures::GestureRecognizer>>
         }
 
         gestureRecognizer = std::make_unique<libgestures::GestureRecognizer>();
+        libgestures::PreviousGestures previousGestures(previous);
         for (const auto gestureNode : gesturesNode) {
-            gestureRecognizer->registerGesture(gestureNode.as<std::shared_ptr<libgestures::Gesture>>());
+            const auto hash = libgestures::PreviousGestures::configHash(QByteArray::fromStdString(Dump(gestureNode)));
+            auto gesture = previousGestures.take(hash);
+            if (!gesture) {
+                gesture = gestureNode.as<std::shared_ptr<libgestures::Gesture>>();
+                gesture->setConfigHash(hash);
+            }
+            gestureRecognizer->registerGesture(gesture);
         }
 
         gestureRecognizer->setDeltaMultiplier(node["delta_multiplier"].as<qreal>(gestureRecognizer->m_deltaMultiplier));
+        gestureRecognizer->setScrollTimeout(node["scroll_timeout"].as<uint32_t>(gestureRecognizer->m_scrollTimeout));
         const auto speedNode = node["speed"];
         if (speedNode.IsDefined()) {
-            gestureRecognizer->setInputEventsToSample(
-                speedNode["events"].as<uint8_t>(gestureRecognizer->m_inputEventsToSample));
+            // Deprecated, events used to be sampled at roughly 100 Hz
+            const auto eventsNode = speedNode["events"];
+            if (eventsNode.IsDefined()) {
+                gestureRecognizer->setSpeedSampleTime(eventsNode.as<uint32_t>() * 10);
+            }
+            gestureRecognizer->setSpeedSampleTime(
+                speedNode["sample_time"].as<uint32_t>(gestureRecognizer->m_speedSampleTime));
+            const auto velocity = [&speedNode](const char *key, const char *deprecatedKey, const qreal &defaultValue) {
+                // Deprecated, thresholds used to be compared against the average delta per event at roughly 100 Hz
+                const auto deprecatedNode = speedNode[deprecatedKey];
+                return speedNode[key].as<qreal>(deprecatedNode.IsDefined() ? deprecatedNode.as<qreal>() * 100 : defaultValue);
+            };
             gestureRecognizer->setSwipeFastThreshold(
-                speedNode["swipe_threshold"].as<qreal>(gestureRecognizer->m_swipeGestureFastThreshold));
+                velocity("swipe_velocity", "swipe_threshold", gestureRecognizer->m_swipeGestureFastThreshold));
             gestureRecognizer->setPinchInFastThreshold(
-                speedNode["pinch_in_threshold"].as<qreal>(gestureRecognizer->m_pinchInFastThreshold));
+                velocity("pinch_in_velocity", "pinch_in_threshold", gestureRecognizer->m_pinchInFastThreshold));
             gestureRecognizer->setPinchOutFastThreshold(
-                speedNode["pinch_out_threshold"].as<qreal>(gestureRecognizer->m_pinchOutFastThreshold));
+                velocity("pinch_out_velocity", "pinch_out_threshold", gestureRecognizer->m_pinchOutFastThreshold));
             gestureRecognizer->setRotateFastThreshold(
-                speedNode["rotate_threshold"].as<qreal>(gestureRecognizer->m_rotateFastThreshold));
+                velocity("rotate_velocity", "rotate_threshold", gestureRecognizer->m_rotateFastThreshold));
         }
 
         return true;
     }
 };
 
+template<>
+struct convert<libgestures::Config>
+{
+    static bool decode(const Node &node, libgestures::Config &config)
+    {
+        return decode(node, config, nullptr);
+    }
+
+    /**
+     * @param previous The previously loaded configuration. Gestures whose nodes haven't changed are reused instead of
+     * being created again. May be nullptr.
+     */
+    static bool decode(const Node &node, libgestures::Config &config, const libgestures::Config *previous)
+    {
+        config.autoReload = node["autoreload"].as<bool>(config.autoReload);
+        config.commandConcurrency = node["command_concurrency"].as<uint32_t>(config.commandConcurrency);
+        config.inputTrace = node["input_trace"].as<QString>(config.inputTrace);
+
+        const auto touchpadNode = node["touchpad"];
+        if (!touchpadNode.IsDefined()) {
+            throw Exception(node.Mark(), "No touchpad configuration specified");
+        }
+        convert<std::shared_ptr<libgestures::GestureRecognizer>>::decode(touchpadNode, config.touchpadGestureRecognizer,
+                                                                          previous ? previous->touchpadGestureRecognizer.get() : nullptr);
+        return true;
+    }
+};
+
 template<>
 struct convert<libgestures::GestureSpeed>
 {
@@ -808,6 +866,26 @@ struct convert<libgestures::GestureSpeed>
     }
 };
 
+template<>
+struct convert<libgestures::CommandCoalescing>
+{
+    static bool decode(const Node &node, libgestures::CommandCoalescing &coalescing)
+    {
+        const auto coalescingRaw = node.as<QString>();
+        if (coalescingRaw == "none") {
+            coalescing = libgestures::CommandCoalescing::None;
+        } else if (coalescingRaw == "drop") {
+            coalescing = libgestures::CommandCoalescing::Drop;
+        } else if (coalescingRaw == "merge") {
+            coalescing = libgestures::CommandCoalescing::Merge;
+        } else {
+            throw Exception(node.Mark(), "Invalid command coalescing policy");
+        }
+
+        return true;
+    }
+};
+
 template<>
 struct convert<libgestures::PinchDirection>
 {
@@ -4,9 +4,16 @@
 namespace libgestures
 {
 
+void TestAction::initTestCase()
+{
+    WindowInfoProvider::setImplementation(new MockWindowInfoProvider(WindowInfo("Firefox", "firefox", "firefox", WindowStates())));
+    m_satisfiedCondition->setWindowClass(QRegularExpression("firefox"));
+    m_unsatisfiedCondition->setWindowClass(QRegularExpression("chrome"));
+}
+
 void TestAction::init()
 {
-    m_action = std::make_shared<GestureAction>();
+    m_action = std::make_shared<MockGestureAction>();
 }
 
 void TestAction::satisfiesConditions_data()
@@ -32,51 +39,36 @@ void TestAction::satisfiesConditions()
     QCOMPARE(m_action->satisfiesConditions(), result);
 }
 
-void TestAction::canExecute_nonRepeatingNotExecuted_returnsTrue()
-{
-    QVERIFY(m_action->canExecute());
-}
-
-void TestAction::canExecute_repeatingNotExecuted_returnsTrue()
+void TestAction::blocksOtherActions_notExecuted_returnsFalse()
 {
-    m_action->setRepeatInterval(1);
-    QVERIFY(m_action->canExecute());
+    m_action->setBlockOtherActions(true);
+    QVERIFY(!m_action->blocksOtherActions());
 }
 
-void TestAction::canExecute_nonRepeatingExecutedOnce_returnsFalse()
+void TestAction::blocksOtherActions_executed_returnsTrue()
 {
+    m_action->setBlockOtherActions(true);
     m_action->tryExecute();
-    QVERIFY(!m_action->canExecute());
+    QVERIFY(m_action->blocksOtherActions());
 }
 
-void TestAction::canExecute_repeatingExecutedOnce_returnsTrue()
+void TestAction::blocksOtherActions_executedAndGestureStartedAgain_returnsFalse()
 {
-    m_action->setRepeatInterval(1);
+    m_action->setBlockOtherActions(true);
     m_action->tryExecute();
-    QVERIFY(m_action->canExecute());
+    m_action->onGestureStarted();
+    QVERIFY(!m_action->blocksOtherActions());
 }
 
-void TestAction::canExecute_nonRepeatingExecutedOnceAndEnded_returnsTrue()
-{
-    m_action->tryExecute();
-    Q_EMIT m_action->gestureEnded();
-    QVERIFY(m_action->canExecute());
-}
-
-void TestAction::canExecute_nonRepeatingExecutedOnceAndCancelled_returnsTrue()
-{
-    m_action->tryExecute();
-    Q_EMIT m_action->gestureCancelled();
-    QVERIFY(m_action->canExecute());
-}
-
-void TestAction::onGestureUpdated_notRepeating_doesntExecuteAction()
+void TestAction::onGestureUpdated_notRepeating_executesActionOncePerUpdate()
 {
     const QSignalSpy spy(m_action.get(), &GestureAction::executed);
 
-    Q_EMIT m_action->gestureUpdated(1);
+    m_action->onGestureUpdated(1, QPointF());
+    m_action->onGestureUpdated(1, QPointF());
 
-    QCOMPARE(spy.count(), 0);
+    QCOMPARE(m_action->m_executions, 2);
+    QCOMPARE(spy.count(), 2);
 }
 
 void TestAction::onGestureUpdated_repeating_data()
@@ -85,16 +77,18 @@ void TestAction::onGestureUpdated_repeating_data()
     QTest::addColumn<int>("delta1");
     QTest::addColumn<int>("delta2");
     QTest::addColumn<int>("actionExecutions");
-
-    QTest::newRow("interval equal to delta") << 10 << 10 << 0 << 1;
-    QTest::newRow("interval greater than delta") << 10 << 9 << 0 << 0;
-    QTest::newRow("interval lesser than delta") << 10 << 11 << 0 << 1;
-    QTest::newRow("negative interval positive delta") << -10 << 10 << 0 << 0;
-    QTest::newRow("positive interval negative delta") << 10 << -10 << 0 << 0;
-    QTest::newRow("multiple executions") << 10 << 55 << 0 << 5;
-    QTest::newRow("two deltas") << 10 << 5 << 5 << 1;
-    QTest::newRow("direction changed 1") << 10 << 20 << -40 << 2;
-    QTest::newRow("direction changed 2") << -10 << -40 << 80 << 4;
+    QTest::addColumn<int>("executedSignals");
+
+    QTest::newRow("interval equal to delta") << 10 << 10 << 0 << 1 << 1;
+    QTest::newRow("interval greater than delta") << 10 << 9 << 0 << 0 << 0;
+    QTest::newRow("interval lesser than delta") << 10 << 11 << 0 << 1 << 1;
+    QTest::newRow("negative interval positive delta") << -10 << 10 << 0 << 0 << 0;
+    QTest::newRow("positive interval negative delta") << 10 << -10 << 0 << 0 << 0;
+    QTest::newRow("multiple executions") << 10 << 55 << 0 << 5 << 1;
+    QTest::newRow("multiple executions twice") << 10 << 25 << 25 << 5 << 2;
+    QTest::newRow("two deltas") << 10 << 5 << 5 << 1 << 1;
+    QTest::newRow("direction changed 1") << 10 << 20 << -40 << 2 << 1;
+    QTest::newRow("direction changed 2") << -10 << -40 << 80 << 4 << 1;
 }
 
 void TestAction::onGestureUpdated_repeating()
@@ -103,14 +97,59 @@ void TestAction::onGestureUpdated_repeating()
     QFETCH(int, delta1);
     QFETCH(int, delta2);
     QFETCH(int, actionExecutions);
+    QFETCH(int, executedSignals);
 
     m_action->setRepeatInterval(interval);
     const QSignalSpy spy(m_action.get(), &GestureAction::executed);
 
-    Q_EMIT m_action->gestureUpdated(delta1);
-    Q_EMIT m_action->gestureUpdated(delta2);
+    m_action->onGestureUpdated(delta1, QPointF());
+    m_action->onGestureUpdated(delta2, QPointF());
+
+    QCOMPARE(m_action->m_executions, actionExecutions);
+    QCOMPARE(spy.count(), executedSignals);
+}
+
+void TestAction::remainingDelta_data()
+{
+    QTest::addColumn<On>("on");
+    QTest::addColumn<qreal>("interval");
+    QTest::addColumn<qreal>("threshold");
+    QTest::addColumn<std::optional<qreal>>("result");
+
+    QTest::newRow("not update") << On::End << static_cast<qreal>(0) << static_cast<qreal>(0) << std::optional<qreal>();
+    QTest::newRow("no interval") << On::Update << static_cast<qreal>(0) << static_cast<qreal>(0) << std::optional<qreal>(0);
+    QTest::newRow("interval") << On::Update << static_cast<qreal>(10) << static_cast<qreal>(0) << std::optional<qreal>(6);
+    QTest::newRow("negative interval") << On::Update << static_cast<qreal>(-10) << static_cast<qreal>(0) << std::optional<qreal>();
+    QTest::newRow("threshold") << On::Update << static_cast<qreal>(0) << static_cast<qreal>(20) << std::optional<qreal>(16);
+    QTest::newRow("threshold and interval") << On::Update << static_cast<qreal>(10) << static_cast<qreal>(20) << std::optional<qreal>(16);
+}
+
+void TestAction::remainingDelta()
+{
+    QFETCH(On, on);
+    QFETCH(qreal, interval);
+    QFETCH(qreal, threshold);
+    QFETCH(std::optional<qreal>, result);
+
+    m_action->setOn(on);
+    m_action->setRepeatInterval(interval);
+    m_action->setThresholds(threshold, 0);
+    m_action->onGestureUpdated(4, QPointF());
+
+    QCOMPARE(m_action->remainingDelta(), result);
+}
+
+void TestAction::tryExecute_inputRepeatedMoreThanMaximum_sequenceSentMaximumTimes()
+{
+    auto *input = new MockInput;
+    Input::setImplementation(input);
+    InputGestureAction action;
+    action.setSequence({InputAction{.keyboardPress = {KEY_A}}});
+
+    QVERIFY(action.tryExecute(UINT32_MAX));
+    QCOMPARE(input->m_keyboardKeys, InputGestureAction::s_maxRepeats);
 
-    QCOMPARE(spy.count(), actionExecutions);
+    Input::setImplementation(new Input);
 }
 
 }
@@ -1,36 +1,73 @@
 #pragma once
 
 #include "libgestures/actions/action.h"
+#include "libgestures/actions/input.h"
 #include "../mockwindowinfoprovider.h"
 #include <QTest>
 
 namespace libgestures
 {
 
+/**
+ * Records the repeat counts the action is executed with.
+ */
+class MockGestureAction : public GestureAction
+{
+public:
+    bool tryExecute(const uint32_t &count = 1) override
+    {
+        if (!GestureAction::tryExecute(count)) {
+            return false;
+        }
+
+        m_executions += count;
+        return true;
+    }
+
+    uint32_t m_executions = 0;
+};
+
+/**
+ * Counts the keys sent.
+ */
+class MockInput : public Input
+{
+public:
+    void keyboardKey(const uint32_t &key, const bool &state) override
+    {
+        m_keyboardKeys++;
+    }
+
+    uint32_t m_keyboardKeys = 0;
+};
+
 class TestAction : public QObject
 {
 Q_OBJECT
 private slots:
+    void initTestCase();
     void init();
 
     void satisfiesConditions_data();
     void satisfiesConditions();
 
-    void canExecute_nonRepeatingNotExecuted_returnsTrue();
-    void canExecute_repeatingNotExecuted_returnsTrue();
-    void canExecute_nonRepeatingExecutedOnce_returnsFalse();
-    void canExecute_repeatingExecutedOnce_returnsTrue();
-    void canExecute_nonRepeatingExecutedOnceAndEnded_returnsTrue();
-    void canExecute_nonRepeatingExecutedOnceAndCancelled_returnsTrue();
+    void blocksOtherActions_notExecuted_returnsFalse();
+    void blocksOtherActions_executed_returnsTrue();
+    void blocksOtherActions_executedAndGestureStartedAgain_returnsFalse();
 
-    void onGestureUpdated_notRepeating_doesntExecuteAction();
+    void onGestureUpdated_notRepeating_executesActionOncePerUpdate();
     void onGestureUpdated_repeating_data();
     void onGestureUpdated_repeating();
+
+    void remainingDelta_data();
+    void remainingDelta();
+
+    void tryExecute_inputRepeatedMoreThanMaximum_sequenceSentMaximumTimes();
 private:
-    const std::shared_ptr<Condition> m_satisfiedCondition = std::make_shared<Condition>(std::make_shared<MockWindowInfoProvider>(WindowInfo("Firefox", "firefox", "firefox", WindowState::Unimportant)));
-    const std::shared_ptr<Condition> m_unsatisfiedCondition = std::make_shared<Condition>(std::make_shared<MockWindowInfoProvider>(std::nullopt));
+    const std::shared_ptr<Condition> m_satisfiedCondition = std::make_shared<Condition>();
+    const std::shared_ptr<Condition> m_unsatisfiedCondition = std::make_shared<Condition>();
 
-    std::shared_ptr<GestureAction> m_action;
+    std::shared_ptr<MockGestureAction> m_action;
 };
 
 }
\ No newline at end of file
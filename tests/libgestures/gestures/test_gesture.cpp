@@ -1,35 +1,159 @@
 #include "test_gesture.h"
 
+#include "libgestures/actions/input.h"
+
+#include <QSignalSpy>
+
 namespace libgestures
 {
 
 void TestGesture::thresholdReached_data()
 {
-    QTest::addColumn<qreal>("threshold");
-    QTest::addColumn<qreal>("accumulatedDelta");
+    QTest::addColumn<qreal>("minimumThreshold");
+    QTest::addColumn<qreal>("maximumThreshold");
+    QTest::addColumn<qreal>("delta");
     QTest::addColumn<bool>("result");
 
-    QTest::newRow("exact") << static_cast<qreal>(10) << static_cast<qreal>(10) << true;
-    QTest::newRow("greater") << static_cast<qreal>(10) << static_cast<qreal>(11) << true;
-    QTest::newRow("lesser") << static_cast<qreal>(10) << static_cast<qreal>(9) << false;
-    QTest::newRow("negative exact") << static_cast<qreal>(-10) << static_cast<qreal>(-10) << true;
-    QTest::newRow("negative greater") << static_cast<qreal>(-10) << static_cast<qreal>(-9) << true;
-    QTest::newRow("negative lesser") << static_cast<qreal>(-10) << static_cast<qreal>(-11) << false;
+    QTest::newRow("no thresholds") << static_cast<qreal>(0) << static_cast<qreal>(0) << static_cast<qreal>(1) << true;
+    QTest::newRow("minimum exact") << static_cast<qreal>(10) << static_cast<qreal>(0) << static_cast<qreal>(10) << true;
+    QTest::newRow("minimum greater") << static_cast<qreal>(10) << static_cast<qreal>(0) << static_cast<qreal>(11) << true;
+    QTest::newRow("minimum lesser") << static_cast<qreal>(10) << static_cast<qreal>(0) << static_cast<qreal>(9) << false;
+    QTest::newRow("minimum negative delta") << static_cast<qreal>(10) << static_cast<qreal>(0) << static_cast<qreal>(-10) << true;
+    QTest::newRow("maximum exact") << static_cast<qreal>(0) << static_cast<qreal>(10) << static_cast<qreal>(10) << true;
+    QTest::newRow("maximum exceeded") << static_cast<qreal>(0) << static_cast<qreal>(10) << static_cast<qreal>(11) << false;
+    QTest::newRow("between") << static_cast<qreal>(5) << static_cast<qreal>(10) << static_cast<qreal>(7) << true;
 }
 
 void TestGesture::thresholdReached()
 {
-    QFETCH(qreal, threshold);
-    QFETCH(qreal, accumulatedDelta);
+    QFETCH(qreal, minimumThreshold);
+    QFETCH(qreal, maximumThreshold);
+    QFETCH(qreal, delta);
+    QFETCH(bool, result);
+
+    HoldGesture gesture;
+    gesture.setThresholds(minimumThreshold, maximumThreshold);
+    auto endedPrematurely = false;
+    gesture.update(delta, QPointF(), endedPrematurely);
+
+    QCOMPARE(gesture.thresholdReached(), result);
+}
+
+void TestGesture::satisfiesUpdateConditions_speed_data()
+{
+    QTest::addColumn<GestureSpeed>("gestureSpeed");
+    QTest::addColumn<GestureSpeed>("speed");
+    QTest::addColumn<bool>("result");
+
+    QTest::newRow("any any") << GestureSpeed::Any << GestureSpeed::Any << true;
+    QTest::newRow("any slow") << GestureSpeed::Any << GestureSpeed::Slow << true;
+    QTest::newRow("any fast") << GestureSpeed::Any << GestureSpeed::Fast << true;
+    QTest::newRow("slow any") << GestureSpeed::Slow << GestureSpeed::Any << false;
+    QTest::newRow("slow slow") << GestureSpeed::Slow << GestureSpeed::Slow << true;
+    QTest::newRow("slow fast") << GestureSpeed::Slow << GestureSpeed::Fast << false;
+    QTest::newRow("fast slow") << GestureSpeed::Fast << GestureSpeed::Slow << false;
+    QTest::newRow("fast fast") << GestureSpeed::Fast << GestureSpeed::Fast << true;
+}
+
+void TestGesture::satisfiesUpdateConditions_speed()
+{
+    QFETCH(GestureSpeed, gestureSpeed);
+    QFETCH(GestureSpeed, speed);
     QFETCH(bool, result);
 
-    auto gesture = std::make_shared<Gesture>();
-    gesture->setThreshold(threshold);
+    SwipeGesture gesture;
+    gesture.setDirection(SwipeDirection::LeftRight);
+    gesture.setSpeed(gestureSpeed);
+
+    QCOMPARE(gesture.satisfiesUpdateConditions(speed, SwipeDirection::Right), result);
+    QVERIFY(!gesture.satisfiesUpdateConditions(speed, SwipeDirection::Up));
+}
+
+void TestGesture::update_signalsEmittedAfterActions()
+{
+    HoldGesture gesture;
+    const auto action = std::make_shared<InputGestureAction>();
+    action->setOn(On::Update);
+    gesture.addAction(action);
+    const QSignalSpy executedSpy(action.get(), &GestureAction::executed);
+
+    auto executionsBeforeGestureUpdated = -1;
+    auto executionsBeforeActionUpdated = -1;
+    connect(&gesture, &Gesture::updated, this, [&executedSpy, &executionsBeforeGestureUpdated](const qreal &, const QPointF &, bool &) {
+        executionsBeforeGestureUpdated = executedSpy.count();
+    });
+    connect(action.get(), &GestureAction::gestureUpdated, this, [&executedSpy, &executionsBeforeActionUpdated](const qreal &, const QPointF &) {
+        executionsBeforeActionUpdated = executedSpy.count();
+    });
+
+    auto endedPrematurely = false;
+    gesture.update(1, QPointF(), endedPrematurely);
+
+    QCOMPARE(executionsBeforeActionUpdated, 1);
+    QCOMPARE(executionsBeforeGestureUpdated, 1);
+}
+
+void TestGesture::update_thresholdNotReached_onlyGestureUpdatedEmitted()
+{
+    HoldGesture gesture;
+    gesture.setThresholds(10, 0);
+    const auto action = std::make_shared<InputGestureAction>();
+    action->setOn(On::Update);
+    gesture.addAction(action);
+    const QSignalSpy startedSpy(&gesture, &Gesture::started);
+    const QSignalSpy actionUpdatedSpy(action.get(), &GestureAction::gestureUpdated);
+    auto gestureUpdates = 0;
+    connect(&gesture, &Gesture::updated, this, [&gestureUpdates](const qreal &, const QPointF &, bool &) {
+        gestureUpdates++;
+    });
+
+    auto endedPrematurely = false;
+    gesture.update(5, QPointF(), endedPrematurely);
+
+    QCOMPARE(gestureUpdates, 1);
+    QCOMPARE(startedSpy.count(), 0);
+    QCOMPARE(actionUpdatedSpy.count(), 0);
+
+    gesture.update(5, QPointF(), endedPrematurely);
+
+    QCOMPARE(gestureUpdates, 2);
+    QCOMPARE(startedSpy.count(), 1);
+    QCOMPARE(actionUpdatedSpy.count(), 1);
+}
+
+void TestGesture::update_benchmark_data()
+{
+    QTest::addColumn<bool>("observed");
+
+    QTest::newRow("direct") << false;
+    // Direct dispatch with an observer connected to every gesture and action signal
+    QTest::newRow("direct with observers") << true;
+}
+
+void TestGesture::update_benchmark()
+{
+    QFETCH(bool, observed);
+
+    HoldGesture gesture;
+    for (auto i = 0; i < 3; i++) {
+        const auto action = std::make_shared<InputGestureAction>();
+        action->setOn(On::Update);
+        gesture.addAction(action);
+        if (observed) {
+            connect(action.get(), &GestureAction::gestureUpdated, this, [](const qreal &, const QPointF &) { });
+        }
+    }
+    if (observed) {
+        connect(&gesture, &Gesture::updated, this, [](const qreal &, const QPointF &, bool &) { });
+    }
 
-    QCOMPARE(gesture->thresholdReached(accumulatedDelta), result);
+    auto endedPrematurely = false;
+    QBENCHMARK {
+        gesture.update(1, QPointF(), endedPrematurely);
+    }
 }
 
 }
 
 QTEST_MAIN(libgestures::TestGesture)
-#include "test_gesture.moc"
\ No newline at end of file
+#include "test_gesture.moc"
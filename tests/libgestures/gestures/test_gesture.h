@@ -1,6 +1,8 @@
 #pragma once
 
 #include "libgestures/gestures/gesture.h"
+#include "libgestures/gestures/holdgesture.h"
+#include "libgestures/gestures/swipegesture.h"
 #include <QTest>
 
 namespace libgestures
@@ -12,6 +14,15 @@ Q_OBJECT
 private slots:
     void thresholdReached_data();
     void thresholdReached();
+
+    void satisfiesUpdateConditions_speed_data();
+    void satisfiesUpdateConditions_speed();
+
+    void update_signalsEmittedAfterActions();
+    void update_thresholdNotReached_onlyGestureUpdatedEmitted();
+
+    void update_benchmark_data();
+    void update_benchmark();
 };
 
 }
\ No newline at end of file
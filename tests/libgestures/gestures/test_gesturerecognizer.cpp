@@ -1,6 +1,34 @@
 #include "test_gesturerecognizer.h"
+#include "libgestures/actions/input.h"
+#include "libgestures/clock.h"
+#include "libgestures/scheduler.h"
 #include <QSignalSpy>
 
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+static std::atomic<uint64_t> s_allocations = 0;
+
+void *operator new(std::size_t size)
+{
+    s_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (auto ptr = std::malloc(size == 0 ? 1 : size)) {
+        return ptr;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void *ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
 namespace libgestures
 {
 
@@ -15,6 +43,12 @@ void TestGestureRecognizer::init()
     m_hold3To4->setFingers(3, 4);
 }
 
+void TestGestureRecognizer::cleanup()
+{
+    // Tests may replace the clock
+    Clock::setImplementation(new Clock);
+}
+
 void TestGestureRecognizer::gestureBegin_calledTwice_hasOneActiveGesture()
 {
     m_gestureRecognizer->registerGesture(m_hold2);
@@ -44,6 +78,171 @@ void TestGestureRecognizer::gestureBegin_twoGesturesWithSatisfiedConditions_hasT
     QCOMPARE(m_gestureRecognizer->m_activeHoldGestures.size(), 2);
 }
 
+void TestGestureRecognizer::gestureBegin_gesturesOfOtherTypesAndFingerCounts_onlyMatchingGestureActive()
+{
+    const auto swipe = std::make_shared<SwipeGesture>();
+    swipe->setFingers(2, 2);
+    m_gestureRecognizer->registerGesture(swipe);
+    m_gestureRecognizer->registerGesture(m_hold3To4);
+    m_gestureRecognizer->registerGesture(m_hold2);
+
+    m_gestureRecognizer->gestureBegin(2, m_gestureRecognizer->m_activeHoldGestures);
+
+    QCOMPARE(m_gestureRecognizer->m_activeHoldGestures.size(), 1);
+    QCOMPARE(*m_gestureRecognizer->m_activeHoldGestures.begin(), m_hold2.get());
+}
+
+void TestGestureRecognizer::gestureBegin_benchmark_data()
+{
+    QTest::addColumn<int>("gestures");
+
+    QTest::newRow("10") << 10;
+    QTest::newRow("100") << 100;
+    QTest::newRow("1000") << 1000;
+}
+
+void TestGestureRecognizer::gestureBegin_benchmark()
+{
+    QFETCH(int, gestures);
+
+    // Only one gesture can match, the cost of beginning should not depend on the amount of other gestures
+    m_gestureRecognizer->registerGesture(m_hold2);
+    for (auto i = 0; i < gestures; i++) {
+        const auto swipe = std::make_shared<SwipeGesture>();
+        swipe->setFingers(2, 2);
+        m_gestureRecognizer->registerGesture(swipe);
+
+        const auto hold = std::make_shared<HoldGesture>();
+        hold->setFingers(3, 4);
+        m_gestureRecognizer->registerGesture(hold);
+    }
+
+    QBENCHMARK {
+        m_gestureRecognizer->holdGestureBegin(2, {});
+        m_gestureRecognizer->holdGestureCancel({});
+    }
+}
+
+void TestGestureRecognizer::hasGestures_gesturesOfOtherTypesAndFingerCounts_onlyMatchingTypeAndFingerCountReturnsTrue()
+{
+    const auto swipe = std::make_shared<SwipeGesture>();
+    swipe->setFingers(3, 4);
+    m_gestureRecognizer->registerGesture(swipe);
+    m_gestureRecognizer->registerGesture(m_hold2);
+
+    QVERIFY(!m_gestureRecognizer->hasGestures(GestureType::Swipe, 2));
+    QVERIFY(m_gestureRecognizer->hasGestures(GestureType::Swipe, 3));
+    QVERIFY(m_gestureRecognizer->hasGestures(GestureType::Swipe, 4));
+    QVERIFY(m_gestureRecognizer->hasGestures(GestureType::Hold, 2));
+    QVERIFY(!m_gestureRecognizer->hasGestures(GestureType::Pinch, 2));
+    QVERIFY(!m_gestureRecognizer->hasGestures(GestureType::Swipe, GestureRecognizer::s_maxFingerCount + 1));
+}
+
+void TestGestureRecognizer::hasGestures_gesturesUnregistered_returnsFalse()
+{
+    m_gestureRecognizer->registerGesture(m_hold2);
+    m_gestureRecognizer->unregisterGestures();
+
+    QVERIFY(!m_gestureRecognizer->hasGestures(GestureType::Hold, 2));
+}
+
+void TestGestureRecognizer::hasActiveGestures_gesturesOfTwoTypesActive_returnsTrueUntilAllEndedOrCancelled()
+{
+    const auto swipe = std::make_shared<SwipeGesture>();
+    swipe->setFingers(2, 2);
+    m_gestureRecognizer->registerGesture(swipe);
+    m_gestureRecognizer->registerGesture(m_hold2);
+
+    QVERIFY(!m_gestureRecognizer->hasActiveGestures());
+
+    m_gestureRecognizer->holdGestureBegin(2, {});
+    QVERIFY(m_gestureRecognizer->hasActiveGestures());
+
+    // Scrolling begins a swipe gesture while the hold gesture is still active
+    m_gestureRecognizer->swipeGestureBegin(2, {});
+    m_gestureRecognizer->holdGestureEnd({});
+    QVERIFY(m_gestureRecognizer->hasActiveGestures());
+
+    m_gestureRecognizer->swipeGestureCancel();
+    QVERIFY(!m_gestureRecognizer->hasActiveGestures());
+}
+
+void TestGestureRecognizer::gestureCycle_noAllocations_data()
+{
+    QTest::addColumn<GestureType>("type");
+
+    QTest::addRow("hold") << GestureType::Hold;
+    QTest::addRow("pinch") << GestureType::Pinch;
+    QTest::addRow("rotate") << GestureType::Rotate;
+    QTest::addRow("swipe") << GestureType::Swipe;
+}
+
+void TestGestureRecognizer::gestureCycle_noAllocations()
+{
+    QFETCH(GestureType, type);
+
+    for (auto i = 0; i < 100; i++) {
+        std::shared_ptr<Gesture> gesture;
+        switch (type) {
+        case GestureType::Hold:
+            gesture = std::make_shared<HoldGesture>();
+            break;
+        case GestureType::Pinch:
+            gesture = std::make_shared<PinchGesture>();
+            break;
+        case GestureType::Rotate:
+            gesture = std::make_shared<RotateGesture>();
+            break;
+        case GestureType::Swipe:
+            gesture = std::make_shared<SwipeGesture>();
+            break;
+        }
+        gesture->setFingers(2, 4);
+
+        const auto action = std::make_shared<InputGestureAction>();
+        action->setOn(i % 2 ? On::End : On::Update);
+        gesture->addAction(action);
+        m_gestureRecognizer->registerGesture(gesture);
+    }
+
+    const auto cycle = [this, &type]() {
+        bool endedPrematurely = false;
+        switch (type) {
+        case GestureType::Hold:
+            m_gestureRecognizer->holdGestureBegin(3, std::chrono::milliseconds(0));
+            for (auto i = 1; i <= 10; i++) {
+                m_gestureRecognizer->holdGestureUpdate(std::chrono::milliseconds(i * 5), endedPrematurely);
+            }
+            m_gestureRecognizer->holdGestureEnd(std::chrono::milliseconds(55));
+            break;
+        case GestureType::Pinch:
+        case GestureType::Rotate:
+            m_gestureRecognizer->pinchGestureBegin(3, std::chrono::milliseconds(0));
+            for (auto i = 1; i <= 30; i++) {
+                const auto scale = type == GestureType::Pinch ? 1 + i * 0.01 : 1;
+                const auto angleDelta = type == GestureType::Rotate ? 1 : 0;
+                m_gestureRecognizer->pinchGestureUpdate(scale, angleDelta, QPointF(), std::chrono::milliseconds(i * 10), endedPrematurely);
+            }
+            m_gestureRecognizer->pinchGestureEnd();
+            break;
+        case GestureType::Swipe:
+            m_gestureRecognizer->swipeGestureBegin(3, std::chrono::milliseconds(0));
+            for (auto i = 1; i <= 10; i++) {
+                m_gestureRecognizer->swipeGestureUpdate(QPointF(5, 0), std::chrono::milliseconds(i * 10), endedPrematurely);
+            }
+            m_gestureRecognizer->swipeGestureEnd();
+            break;
+        }
+    };
+
+    // Lazily initialized state, such as the active window cache
+    cycle();
+
+    const auto allocations = s_allocations.load();
+    cycle();
+    QCOMPARE(s_allocations.load() - allocations, 0);
+}
+
 void TestGestureRecognizer::gestureCancel_twoActiveGestures_gestureCancelledSignalEmittedForAllGesturesAndActiveHoldGesturesCleared()
 {
     const QSignalSpy spy1(m_hold2To3.get(), &Gesture::cancelled);
@@ -80,32 +279,111 @@ void TestGestureRecognizer::gestureEnd_activeGesture_gestureEndedSignalEmittedAn
 void TestGestureRecognizer::holdGestureUpdate_twoActiveGesturesAndOneEndsPrematurely_endedPrematurelySetToTrueAndOnlyOneGestureUpdatedAndReturnsTrue()
 {
     const auto gesture1 = std::make_shared<HoldGesture>();
-    gesture1->setThreshold(1);
+    gesture1->setThresholds(1, 0);
     gesture1->setFingers(2, 2);
-    gesture1->setTriggerWhenThresholdReached(true);
-    const auto action = std::make_shared<GestureAction>();
+    const auto action = std::make_shared<InputGestureAction>();
     action->setBlockOtherActions(true);
     gesture1->addAction(action);
     const auto gesture2 = std::make_shared<HoldGesture>();
-    gesture2->setThreshold(1);
+    gesture2->setThresholds(1, 0);
     gesture2->setFingers(2, 2);
-    gesture2->setTriggerWhenThresholdReached(true);
 
     gestureUpdate_twoActiveGesturesAndOneEndsPrematurely_endedPrematurelySetToTrueAndOnlyOneGestureUpdatedAndReturnsTrue(
         gesture1,
         gesture2,
         [this]()
         {
-            m_gestureRecognizer->holdGestureBegin(2);
+            m_gestureRecognizer->holdGestureBegin(2, std::chrono::milliseconds(0));
         },
         [this](bool &endedPrematurely)
         {
-            m_gestureRecognizer->holdGestureUpdate(1, endedPrematurely);
+            m_gestureRecognizer->holdGestureUpdate(std::chrono::milliseconds(1), endedPrematurely);
             return true;
         }
     );
 }
 
+void TestGestureRecognizer::holdGestureUpdate_scheduledWithVirtualClock_hourOfHoldGesturesReplayedWithoutWaiting()
+{
+    const auto clock = new VirtualClock;
+    Clock::setImplementation(clock);
+    Scheduler scheduler;
+
+    const auto gesture = std::make_shared<HoldGesture>();
+    gesture->setFingers(3, 3);
+    gesture->setThresholds(1000, 0);
+    const auto action = std::make_shared<InputGestureAction>();
+    action->setOn(On::Update);
+    action->setRepeatInterval(100);
+    gesture->addAction(action);
+    const QSignalSpy startedSpy(gesture.get(), &Gesture::started);
+    const QSignalSpy executedSpy(action.get(), &GestureAction::executed);
+    m_gestureRecognizer->registerGesture(gesture);
+
+    // Same as the input filter
+    Scheduler::TaskId updateTask;
+    updateTask = scheduler.addTask([this, clock, &scheduler, &updateTask]() {
+        bool endedPrematurely = false;
+        m_gestureRecognizer->holdGestureUpdate(clock->now(), endedPrematurely);
+        if (const auto nextUpdate = m_gestureRecognizer->holdGestureNextUpdate()) {
+            scheduler.schedule(updateTask, *nextUpdate);
+        }
+    });
+
+    // 2 second holds, the threshold is reached after 1 second and the action is executed every 100 ms from then on. The
+    // first update carries the entire second, so its 10 executions are performed as one batch.
+    for (auto i = 0; i < 1800; i++) {
+        m_gestureRecognizer->holdGestureBegin(3, clock->now());
+        scheduler.schedule(updateTask, m_gestureRecognizer->holdGestureNextUpdate().value());
+        clock->advance(std::chrono::seconds(2), &scheduler);
+        scheduler.cancel(updateTask);
+        m_gestureRecognizer->holdGestureEnd(clock->now());
+    }
+
+    QVERIFY(clock->now() == std::chrono::hours(1));
+    QCOMPARE(startedSpy.count(), 1800);
+    QCOMPARE(executedSpy.count(), 1800 * 11);
+}
+
+void TestGestureRecognizer::holdGestureEnd_endActionWithThresholdAndNoUpdatesScheduled_thresholdCheckedAgainstEndTime_data()
+{
+    QTest::addColumn<qreal>("minimumThreshold");
+    QTest::addColumn<qreal>("maximumThreshold");
+    QTest::addColumn<int>("endTime");
+    QTest::addColumn<bool>("executed");
+
+    QTest::newRow("minimum reached") << static_cast<qreal>(1000) << static_cast<qreal>(0) << 1500 << true;
+    QTest::newRow("minimum not reached") << static_cast<qreal>(1000) << static_cast<qreal>(0) << 800 << false;
+    QTest::newRow("maximum exceeded") << static_cast<qreal>(0) << static_cast<qreal>(1000) << 1500 << false;
+    QTest::newRow("maximum not exceeded") << static_cast<qreal>(0) << static_cast<qreal>(1000) << 800 << true;
+}
+
+void TestGestureRecognizer::holdGestureEnd_endActionWithThresholdAndNoUpdatesScheduled_thresholdCheckedAgainstEndTime()
+{
+    QFETCH(qreal, minimumThreshold);
+    QFETCH(qreal, maximumThreshold);
+    QFETCH(int, endTime);
+    QFETCH(bool, executed);
+
+    const auto gesture = std::make_shared<HoldGesture>();
+    gesture->setFingers(2, 2);
+    const auto action = std::make_shared<InputGestureAction>();
+    action->setOn(On::End);
+    action->setThresholds(minimumThreshold, maximumThreshold);
+    gesture->addAction(action);
+    const QSignalSpy executedSpy(action.get(), &GestureAction::executed);
+    m_gestureRecognizer->registerGesture(gesture);
+
+    m_gestureRecognizer->holdGestureBegin(2, std::chrono::milliseconds(0));
+    bool endedPrematurely = false;
+    m_gestureRecognizer->holdGestureUpdate(m_gestureRecognizer->holdGestureNextUpdate().value(), endedPrematurely);
+    // Once started, no update can have an effect on the gesture
+    QVERIFY(!m_gestureRecognizer->holdGestureNextUpdate());
+    m_gestureRecognizer->holdGestureEnd(std::chrono::milliseconds(endTime));
+
+    QCOMPARE(executedSpy.count(), executed ? 1 : 0);
+}
+
 void TestGestureRecognizer::pinchGestureUpdate_directions_data()
 {
     QTest::addColumn<PinchDirection>("direction");
@@ -139,7 +417,7 @@ void TestGestureRecognizer::pinchGestureUpdate_directions()
         [this, &delta]()
         {
             bool _ = false;
-            return m_gestureRecognizer->pinchGestureUpdate(delta, 0, QPointF(), _);
+            return m_gestureRecognizer->pinchGestureUpdate(delta, 0, QPointF(), {}, _);
         },
         correct
     );
@@ -149,28 +427,26 @@ void TestGestureRecognizer::pinchGestureUpdate_twoActiveGesturesAndOneEndsPremat
 {
     const auto gesture1 = std::make_shared<PinchGesture>();
     gesture1->setDirection(PinchDirection::Out);
-    gesture1->setThreshold(0.1);
+    gesture1->setThresholds(0.1, 0);
     gesture1->setFingers(2, 2);
-    gesture1->setTriggerWhenThresholdReached(true);
-    const auto action = std::make_shared<GestureAction>();
+    const auto action = std::make_shared<InputGestureAction>();
     action->setBlockOtherActions(true);
     gesture1->addAction(action);
     const auto gesture2 = std::make_shared<PinchGesture>();
     gesture2->setDirection(PinchDirection::Out);
-    gesture2->setThreshold(0.1);
+    gesture2->setThresholds(0.1, 0);
     gesture2->setFingers(2, 2);
-    gesture2->setTriggerWhenThresholdReached(true);
 
     gestureUpdate_twoActiveGesturesAndOneEndsPrematurely_endedPrematurelySetToTrueAndOnlyOneGestureUpdatedAndReturnsTrue(
         gesture1,
         gesture2,
         [this]()
         {
-            m_gestureRecognizer->pinchGestureBegin(2);
+            m_gestureRecognizer->pinchGestureBegin(2, {});
         },
         [this](bool &endedPrematurely)
         {
-            m_gestureRecognizer->pinchGestureUpdate(1.1, 0, QPointF(), endedPrematurely);
+            m_gestureRecognizer->pinchGestureUpdate(1.1, 0, QPointF(), {}, endedPrematurely);
             return true;
         }
     );
@@ -196,9 +472,9 @@ void TestGestureRecognizer::swipeGestureUpdate_directions_data()
             else if (expectedDirection == "down")
                 swipeDirection = SwipeDirection::Down;
             else if (expectedDirection == "leftright")
-                swipeDirection = SwipeDirection::Horizontal;
+                swipeDirection = SwipeDirection::LeftRight;
             else if (expectedDirection == "updown")
-                swipeDirection = SwipeDirection::Vertical;
+                swipeDirection = SwipeDirection::UpDown;
             else
                 Q_UNREACHABLE();
 
@@ -215,8 +491,8 @@ void TestGestureRecognizer::swipeGestureUpdate_directions_data()
                 Q_UNREACHABLE();
 
             bool correct = (expectedDirection == direction)
-                || (swipeDirection == SwipeDirection::Horizontal && (direction == "left" || direction == "right"))
-                || (swipeDirection == SwipeDirection::Vertical && (direction == "up" || direction == "down"));
+                || (swipeDirection == SwipeDirection::LeftRight && (direction == "left" || direction == "right"))
+                || (swipeDirection == SwipeDirection::UpDown && (direction == "up" || direction == "down"));
 
             QTest::addRow("%s %s %s", expectedDirection.toStdString().c_str(), direction.toStdString().c_str(), correct ? "correct" : "wrong")
                 << swipeDirection << delta << correct;
@@ -243,7 +519,7 @@ void TestGestureRecognizer::swipeGestureUpdate_directions()
         [this, &delta]()
         {
             bool _ = false;
-            return m_gestureRecognizer->swipeGestureUpdate(delta, _);
+            return m_gestureRecognizer->swipeGestureUpdate(delta, {}, _);
         },
         correct
     );
@@ -253,33 +529,170 @@ void TestGestureRecognizer::swipeGestureUpdate_twoActiveGesturesAndOneEndsPremat
 {
     const auto gesture1 = std::make_shared<SwipeGesture>();
     gesture1->setDirection(SwipeDirection::Right);
-    gesture1->setThreshold(1);
+    gesture1->setThresholds(1, 0);
     gesture1->setFingers(3, 3);
-    gesture1->setTriggerWhenThresholdReached(true);
-    const auto action = std::make_shared<GestureAction>();
+    const auto action = std::make_shared<InputGestureAction>();
     action->setBlockOtherActions(true);
     gesture1->addAction(action);
     const auto gesture2 = std::make_shared<SwipeGesture>();
     gesture2->setDirection(SwipeDirection::Right);
-    gesture2->setThreshold(1);
+    gesture2->setThresholds(1, 0);
     gesture2->setFingers(3, 3);
-    gesture2->setTriggerWhenThresholdReached(true);
 
     gestureUpdate_twoActiveGesturesAndOneEndsPrematurely_endedPrematurelySetToTrueAndOnlyOneGestureUpdatedAndReturnsTrue(
         gesture1,
         gesture2,
         [this]()
         {
-            m_gestureRecognizer->swipeGestureBegin(3);
+            m_gestureRecognizer->swipeGestureBegin(3, {});
         },
         [this](bool &endedPrematurely)
         {
-            m_gestureRecognizer->swipeGestureUpdate(QPointF(1, 0), endedPrematurely);
+            m_gestureRecognizer->swipeGestureUpdate(QPointF(1, 0), {}, endedPrematurely);
             return true;
         }
     );
 }
 
+void TestGestureRecognizer::swipeGestureUpdate_speedBeingDetermined_onlyGesturesWithoutSpeedUpdated()
+{
+    const auto anySpeed = std::make_shared<SwipeGesture>();
+    anySpeed->setFingers(3, 3);
+    anySpeed->setDirection(SwipeDirection::Right);
+    const auto slow = std::make_shared<SwipeGesture>();
+    slow->setFingers(3, 3);
+    slow->setDirection(SwipeDirection::Right);
+    slow->setSpeed(GestureSpeed::Slow);
+    const QSignalSpy anySpeedSpy(anySpeed.get(), &Gesture::updated);
+    const QSignalSpy slowSpy(slow.get(), &Gesture::updated);
+    m_gestureRecognizer->registerGesture(anySpeed);
+    m_gestureRecognizer->registerGesture(slow);
+
+    bool endedPrematurely = false;
+    m_gestureRecognizer->swipeGestureBegin(3, std::chrono::milliseconds(0));
+    QVERIFY(m_gestureRecognizer->swipeGestureUpdate(QPointF(1, 0), std::chrono::milliseconds(10), endedPrematurely));
+
+    QCOMPARE(anySpeedSpy.count(), 1);
+    QCOMPARE(slowSpy.count(), 0);
+}
+
+void TestGestureRecognizer::swipeGestureUpdate_speedBeingDeterminedAndGestureWithoutSpeedBlocksOtherActions_gestureWithSpeedNotUpdated()
+{
+    // Registered first, but gestures without speed are updated before the speed is determined
+    const auto slow = std::make_shared<SwipeGesture>();
+    slow->setFingers(3, 3);
+    slow->setDirection(SwipeDirection::Right);
+    slow->setSpeed(GestureSpeed::Slow);
+    const auto anySpeed = std::make_shared<SwipeGesture>();
+    anySpeed->setFingers(3, 3);
+    anySpeed->setDirection(SwipeDirection::Right);
+    const auto action = std::make_shared<InputGestureAction>();
+    action->setBlockOtherActions(true);
+    anySpeed->addAction(action);
+    const QSignalSpy slowSpy(slow.get(), &Gesture::updated);
+    m_gestureRecognizer->registerGesture(slow);
+    m_gestureRecognizer->registerGesture(anySpeed);
+
+    bool endedPrematurely = false;
+    m_gestureRecognizer->swipeGestureBegin(3, std::chrono::milliseconds(0));
+    QVERIFY(m_gestureRecognizer->swipeGestureUpdate(QPointF(1, 0), std::chrono::milliseconds(10), endedPrematurely));
+
+    QVERIFY(endedPrematurely);
+    QCOMPARE(slowSpy.count(), 0);
+}
+
+void TestGestureRecognizer::swipeGestureUpdate_fastMotion_speedDeterminedBeforeSampleTimeElapsed()
+{
+    const auto fast = std::make_shared<SwipeGesture>();
+    fast->setFingers(3, 3);
+    fast->setDirection(SwipeDirection::Right);
+    fast->setSpeed(GestureSpeed::Fast);
+    const QSignalSpy spy(fast.get(), &Gesture::updated);
+    m_gestureRecognizer->setSpeedSampleTime(30);
+    m_gestureRecognizer->setSwipeFastThreshold(1000);
+    m_gestureRecognizer->registerGesture(fast);
+
+    // 30 units in 10 ms, 3000 units per second
+    bool endedPrematurely = false;
+    m_gestureRecognizer->swipeGestureBegin(3, std::chrono::milliseconds(0));
+    m_gestureRecognizer->swipeGestureUpdate(QPointF(30, 0), std::chrono::milliseconds(10), endedPrematurely);
+
+    QCOMPARE(m_gestureRecognizer->m_speed, GestureSpeed::Fast);
+    QCOMPARE(spy.count(), 1);
+}
+
+void TestGestureRecognizer::swipeGestureUpdate_velocityReachesThresholdBeforeAverage_fastDeterminedEarly()
+{
+    const auto fast = std::make_shared<SwipeGesture>();
+    fast->setFingers(3, 3);
+    fast->setDirection(SwipeDirection::Right);
+    fast->setSpeed(GestureSpeed::Fast);
+    m_gestureRecognizer->setSpeedSampleTime(30);
+    m_gestureRecognizer->setSwipeFastThreshold(1000);
+    m_gestureRecognizer->registerGesture(fast);
+
+    // 100 units per second, then 5000 units per second. The estimated velocity reaches 1000 units per second, while
+    // 16 units are far from the 30 units needed to average 1000 units per second over the sample time.
+    bool endedPrematurely = false;
+    m_gestureRecognizer->swipeGestureBegin(3, std::chrono::milliseconds(0));
+    m_gestureRecognizer->swipeGestureUpdate(QPointF(1, 0), std::chrono::milliseconds(10), endedPrematurely);
+    QVERIFY(m_gestureRecognizer->m_isDeterminingSpeed);
+    m_gestureRecognizer->swipeGestureUpdate(QPointF(15, 0), std::chrono::milliseconds(13), endedPrematurely);
+
+    QVERIFY(!m_gestureRecognizer->m_isDeterminingSpeed);
+    QCOMPARE(m_gestureRecognizer->m_speed, GestureSpeed::Fast);
+}
+
+void TestGestureRecognizer::swipeGestureUpdate_slowMotion_bufferedUpdatesReplayedOnceSampleTimeElapsed()
+{
+    const auto slow = std::make_shared<SwipeGesture>();
+    slow->setFingers(3, 3);
+    slow->setDirection(SwipeDirection::Right);
+    slow->setSpeed(GestureSpeed::Slow);
+    const auto fast = std::make_shared<SwipeGesture>();
+    fast->setFingers(3, 3);
+    fast->setDirection(SwipeDirection::Right);
+    fast->setSpeed(GestureSpeed::Fast);
+    const QSignalSpy slowSpy(slow.get(), &Gesture::updated);
+    const QSignalSpy fastCancelledSpy(fast.get(), &Gesture::cancelled);
+    m_gestureRecognizer->setSpeedSampleTime(30);
+    m_gestureRecognizer->setSwipeFastThreshold(1000);
+    m_gestureRecognizer->registerGesture(slow);
+    m_gestureRecognizer->registerGesture(fast);
+
+    bool endedPrematurely = false;
+    m_gestureRecognizer->swipeGestureBegin(3, std::chrono::milliseconds(0));
+    m_gestureRecognizer->swipeGestureUpdate(QPointF(1, 0), std::chrono::milliseconds(10), endedPrematurely);
+    m_gestureRecognizer->swipeGestureUpdate(QPointF(1, 0), std::chrono::milliseconds(20), endedPrematurely);
+    QCOMPARE(slowSpy.count(), 0);
+
+    m_gestureRecognizer->swipeGestureUpdate(QPointF(1, 0), std::chrono::milliseconds(30), endedPrematurely);
+    QCOMPARE(m_gestureRecognizer->m_speed, GestureSpeed::Slow);
+    QCOMPARE(slowSpy.count(), 3);
+    QCOMPARE(fastCancelledSpy.count(), 1);
+}
+
+void TestGestureRecognizer::swipeGestureEnd_speedBeingDetermined_bufferedUpdatesReplayed()
+{
+    const auto slow = std::make_shared<SwipeGesture>();
+    slow->setFingers(3, 3);
+    slow->setDirection(SwipeDirection::Right);
+    slow->setSpeed(GestureSpeed::Slow);
+    const QSignalSpy spy(slow.get(), &Gesture::updated);
+    m_gestureRecognizer->setSpeedSampleTime(30);
+    m_gestureRecognizer->setSwipeFastThreshold(1000);
+    m_gestureRecognizer->registerGesture(slow);
+
+    // 5 units in 10 ms is 500 units per second, which could still change before the sample time elapses
+    bool endedPrematurely = false;
+    m_gestureRecognizer->swipeGestureBegin(3, std::chrono::milliseconds(0));
+    m_gestureRecognizer->swipeGestureUpdate(QPointF(5, 0), std::chrono::milliseconds(10), endedPrematurely);
+    QCOMPARE(spy.count(), 0);
+    m_gestureRecognizer->swipeGestureEnd();
+
+    QCOMPARE(spy.count(), 1);
+}
+
 void TestGestureRecognizer::gestureUpdate_directions(
     std::shared_ptr<Gesture> gesture,
     std::function<void()> gestureBegin,
@@ -9,10 +9,22 @@ class TestGestureRecognizer : public QObject
     Q_OBJECT
 private slots:
     void init();
+    void cleanup();
 
     void gestureBegin_calledTwice_hasOneActiveGesture();
     void gestureBegin_gestureConditionsNotSatisfied_hasNoActiveGestures();
     void gestureBegin_twoGesturesWithSatisfiedConditions_hasTwoActiveGestures();
+    void gestureBegin_gesturesOfOtherTypesAndFingerCounts_onlyMatchingGestureActive();
+    void gestureBegin_benchmark_data();
+    void gestureBegin_benchmark();
+
+    void hasGestures_gesturesOfOtherTypesAndFingerCounts_onlyMatchingTypeAndFingerCountReturnsTrue();
+    void hasGestures_gesturesUnregistered_returnsFalse();
+
+    void hasActiveGestures_gesturesOfTwoTypesActive_returnsTrueUntilAllEndedOrCancelled();
+
+    void gestureCycle_noAllocations_data();
+    void gestureCycle_noAllocations();
 
     void gestureCancel_twoActiveGestures_gestureCancelledSignalEmittedForAllGesturesAndActiveHoldGesturesCleared();
 
@@ -20,6 +32,10 @@ private slots:
     void gestureEnd_activeGesture_gestureEndedSignalEmittedAndActiveHoldGesturesClearedAndReturnsTrue();
 
     void holdGestureUpdate_twoActiveGesturesAndOneEndsPrematurely_endedPrematurelySetToTrueAndOnlyOneGestureUpdatedAndReturnsTrue();
+    void holdGestureUpdate_scheduledWithVirtualClock_hourOfHoldGesturesReplayedWithoutWaiting();
+
+    void holdGestureEnd_endActionWithThresholdAndNoUpdatesScheduled_thresholdCheckedAgainstEndTime_data();
+    void holdGestureEnd_endActionWithThresholdAndNoUpdatesScheduled_thresholdCheckedAgainstEndTime();
 
     void pinchGestureUpdate_directions_data();
     void pinchGestureUpdate_directions();
@@ -28,6 +44,13 @@ private slots:
     void swipeGestureUpdate_directions_data();
     void swipeGestureUpdate_directions();
     void swipeGestureUpdate_twoActiveGesturesAndOneEndsPrematurely_endedPrematurelySetToTrueAndOnlyOneGestureUpdatedAndReturnsTrue();
+    void swipeGestureUpdate_speedBeingDetermined_onlyGesturesWithoutSpeedUpdated();
+    void swipeGestureUpdate_speedBeingDeterminedAndGestureWithoutSpeedBlocksOtherActions_gestureWithSpeedNotUpdated();
+    void swipeGestureUpdate_fastMotion_speedDeterminedBeforeSampleTimeElapsed();
+    void swipeGestureUpdate_velocityReachesThresholdBeforeAverage_fastDeterminedEarly();
+    void swipeGestureUpdate_slowMotion_bufferedUpdatesReplayedOnceSampleTimeElapsed();
+
+    void swipeGestureEnd_speedBeingDetermined_bufferedUpdatesReplayed();
 private:
     void gestureUpdate_directions(
         std::shared_ptr<Gesture> gesture,
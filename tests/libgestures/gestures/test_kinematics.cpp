@@ -0,0 +1,57 @@
+#include "test_kinematics.h"
+
+namespace libgestures
+{
+
+void TestKinematics::update_constantVelocity_velocityInUnitsPerSecond_data()
+{
+    QTest::addColumn<int>("interval");
+
+    QTest::addRow("60 Hz") << 16667;
+    QTest::addRow("125 Hz") << 8000;
+    QTest::addRow("240 Hz") << 4167;
+}
+
+void TestKinematics::update_constantVelocity_velocityInUnitsPerSecond()
+{
+    QFETCH(int, interval);
+
+    // 1000 units per second regardless of how often the device sends events
+    Kinematics kinematics;
+    kinematics.reset(std::chrono::microseconds(0));
+    for (int i = 1; i <= 20; i++) {
+        kinematics.update(interval / 1000.0, std::chrono::microseconds(i * interval));
+    }
+
+    QCOMPARE(kinematics.velocity(), 1000);
+}
+
+void TestKinematics::update_sameTimestamp_deltaCombinedWithNextSample()
+{
+    Kinematics kinematics;
+    kinematics.reset(std::chrono::microseconds(0));
+    kinematics.update(5, std::chrono::microseconds(0));
+    QCOMPARE(kinematics.velocity(), 0);
+
+    kinematics.update(5, std::chrono::milliseconds(10));
+    QCOMPARE(kinematics.velocity(), 1000);
+}
+
+void TestKinematics::reset_samplesDiscarded()
+{
+    Kinematics kinematics;
+    kinematics.reset(std::chrono::microseconds(0));
+    kinematics.update(10, std::chrono::milliseconds(10));
+    kinematics.update(20, std::chrono::milliseconds(20));
+
+    kinematics.reset(std::chrono::milliseconds(20));
+    QCOMPARE(kinematics.velocity(), 0);
+
+    kinematics.update(1, std::chrono::milliseconds(30));
+    QCOMPARE(kinematics.velocity(), 100);
+}
+
+}
+
+QTEST_MAIN(libgestures::TestKinematics)
+#include "test_kinematics.moc"
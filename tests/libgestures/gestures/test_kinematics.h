@@ -0,0 +1,19 @@
+#pragma once
+
+#include "libgestures/gestures/kinematics.h"
+#include <QTest>
+
+namespace libgestures
+{
+
+class TestKinematics : public QObject
+{
+    Q_OBJECT
+private slots:
+    void update_constantVelocity_velocityInUnitsPerSecond_data();
+    void update_constantVelocity_velocityInUnitsPerSecond();
+    void update_sameTimestamp_deltaCombinedWithNextSample();
+    void reset_samplesDiscarded();
+};
+
+}
@@ -12,7 +12,13 @@ MockWindowInfoProvider::MockWindowInfoProvider(std::optional<const WindowInfo> i
 
 std::optional<const WindowInfo> MockWindowInfoProvider::activeWindow() const
 {
+    m_activeWindowCalls++;
     return m_info;
 }
 
+const uint32_t &MockWindowInfoProvider::activeWindowCalls() const
+{
+    return m_activeWindowCalls;
+}
+
 }
\ No newline at end of file
@@ -9,8 +9,14 @@ public:
     explicit MockWindowInfoProvider(std::optional<const WindowInfo> info);
 
     [[nodiscard]] std::optional<const WindowInfo> activeWindow() const override;
+
+    /**
+     * @return How many times activeWindow() has been called.
+     */
+    const uint32_t &activeWindowCalls() const;
 private:
     const std::optional<const WindowInfo> m_info;
+    mutable uint32_t m_activeWindowCalls = 0;
 };
 
 }
\ No newline at end of file
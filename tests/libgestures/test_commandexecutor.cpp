@@ -0,0 +1,140 @@
+#include "test_commandexecutor.h"
+
+namespace libgestures
+{
+
+void TestCommandExecutor::command_data()
+{
+    QTest::addColumn<QString>("command");
+    QTest::addColumn<QStringList>("arguments");
+
+    QTest::newRow("program") << "kwrite" << QStringList{"kwrite"};
+    QTest::newRow("arguments") << "kwrite  a.txt b.txt" << QStringList{"kwrite", "a.txt", "b.txt"};
+    QTest::newRow("tab") << "kwrite\ta.txt" << QStringList{"kwrite", "a.txt"};
+    QTest::newRow("single quotes") << "kwrite 'a b.txt'" << QStringList{"/bin/sh", "-c", "kwrite 'a b.txt'"};
+    QTest::newRow("double quotes") << "kwrite \"a b.txt\"" << QStringList{"/bin/sh", "-c", "kwrite \"a b.txt\""};
+    QTest::newRow("escaped space") << "kwrite a\\ b.txt" << QStringList{"/bin/sh", "-c", "kwrite a\\ b.txt"};
+    QTest::newRow("pipe") << "echo a | wc -c" << QStringList{"/bin/sh", "-c", "echo a | wc -c"};
+    QTest::newRow("variable") << "kwrite $HOME/a.txt" << QStringList{"/bin/sh", "-c", "kwrite $HOME/a.txt"};
+    QTest::newRow("home") << "kwrite ~/a.txt" << QStringList{"/bin/sh", "-c", "kwrite ~/a.txt"};
+    QTest::newRow("empty") << "" << QStringList{};
+    QTest::newRow("whitespace") << "  \t " << QStringList{};
+}
+
+void TestCommandExecutor::command()
+{
+    QFETCH(QString, command);
+    QFETCH(QStringList, arguments);
+
+    const Command parsedCommand(command);
+
+    QStringList parsedArguments;
+    for (const auto &argument : parsedCommand.m_arguments) {
+        parsedArguments << QString::fromStdString(argument);
+    }
+    QCOMPARE(parsedArguments, arguments);
+    QCOMPARE(parsedCommand.m_argv.size(), parsedCommand.m_arguments.size() + 1);
+    QVERIFY(!parsedCommand.m_argv.back());
+}
+
+void TestCommandExecutor::execute_emptyCommand_notQueuedAndCountedAsFailed()
+{
+    CommandExecutor executor;
+
+    QVERIFY(!executor.execute(std::make_shared<Command>(""), CommandCoalescing::None));
+    QCOMPARE(executor.failed(), 1);
+    QCOMPARE(executor.queued(), 0);
+}
+
+void TestCommandExecutor::execute_exitStatus_completedAndFailedCounted()
+{
+    CommandExecutor executor;
+
+    QVERIFY(executor.execute(std::make_shared<Command>("true"), CommandCoalescing::None));
+    QVERIFY(executor.execute(std::make_shared<Command>("false"), CommandCoalescing::None));
+    QVERIFY(executor.execute(std::make_shared<Command>("kwin-gestures-nonexistent-command"), CommandCoalescing::None));
+
+    QTRY_COMPARE(executor.completed() + executor.failed(), 3);
+    QCOMPARE(executor.completed(), 1);
+    QCOMPARE(executor.failed(), 2);
+}
+
+void TestCommandExecutor::execute_longRunningCommandsOverPreviousDefaultLimit_laterCommandsStarted()
+{
+    CommandExecutor executor;
+    // Launched applications keep running, they must not prevent further commands from starting
+    const auto longRunning = std::make_shared<Command>("sleep 30");
+    for (auto i = 0; i < 20; i++) {
+        QVERIFY(executor.execute(longRunning, CommandCoalescing::None));
+    }
+
+    QVERIFY(executor.execute(std::make_shared<Command>("true"), CommandCoalescing::None));
+
+    QTRY_COMPARE(executor.completed(), 1);
+    QCOMPARE(executor.queued(), 0);
+    QCOMPARE(executor.dropped(), 0);
+}
+
+void TestCommandExecutor::execute_coalescingNone_allExecutionsQueued()
+{
+    CommandExecutor executor;
+    executor.setConcurrencyLimit(1);
+    // Occupies the only slot, so that further executions stay queued
+    QVERIFY(executor.execute(std::make_shared<Command>("sleep 1"), CommandCoalescing::None));
+    const auto command = std::make_shared<Command>("true");
+
+    for (auto i = 0; i < 3; i++) {
+        QVERIFY(executor.execute(command, CommandCoalescing::None));
+    }
+    QCOMPARE(executor.dropped(), 0);
+}
+
+void TestCommandExecutor::execute_coalescingDrop_droppedWhileRunningOrQueued()
+{
+    CommandExecutor executor;
+    const auto command = std::make_shared<Command>("sleep 1");
+
+    QVERIFY(executor.execute(command, CommandCoalescing::Drop));
+    QVERIFY(!executor.execute(command, CommandCoalescing::Drop));
+    QTRY_COMPARE(executor.queued(), 0);
+    QVERIFY(!executor.execute(command, CommandCoalescing::Drop));
+    QCOMPARE(executor.dropped(), 2);
+}
+
+void TestCommandExecutor::execute_coalescingMerge_mergedIntoQueuedExecution()
+{
+    CommandExecutor executor;
+    executor.setConcurrencyLimit(1);
+    QVERIFY(executor.execute(std::make_shared<Command>("sleep 1"), CommandCoalescing::None));
+    const auto command = std::make_shared<Command>("true");
+
+    QVERIFY(executor.execute(command, CommandCoalescing::Merge));
+    QVERIFY(!executor.execute(command, CommandCoalescing::Merge));
+    QVERIFY(!executor.execute(command, CommandCoalescing::Merge));
+    QCOMPARE(executor.dropped(), 2);
+}
+
+void TestCommandExecutor::execute_queueFull_executionsDropped()
+{
+    CommandExecutor executor;
+    executor.setConcurrencyLimit(1);
+    QVERIFY(executor.execute(std::make_shared<Command>("sleep 1"), CommandCoalescing::None));
+    QTRY_COMPARE(executor.queued(), 0);
+    const auto command = std::make_shared<Command>("true");
+
+    auto queued = 0;
+    for (size_t i = 0; i < CommandExecutor::s_maxQueued + 6; i++) {
+        if (executor.execute(command, CommandCoalescing::None)) {
+            queued++;
+        }
+    }
+
+    QCOMPARE(queued, CommandExecutor::s_maxQueued);
+    QCOMPARE(executor.queued(), CommandExecutor::s_maxQueued);
+    QCOMPARE(executor.dropped(), 6);
+}
+
+}
+
+QTEST_MAIN(libgestures::TestCommandExecutor)
+#include "test_commandexecutor.moc"
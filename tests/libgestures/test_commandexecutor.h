@@ -0,0 +1,25 @@
+#pragma once
+
+#include "libgestures/commandexecutor.h"
+#include <QTest>
+
+namespace libgestures
+{
+
+class TestCommandExecutor : public QObject
+{
+    Q_OBJECT
+private slots:
+    void command_data();
+    void command();
+
+    void execute_emptyCommand_notQueuedAndCountedAsFailed();
+    void execute_exitStatus_completedAndFailedCounted();
+    void execute_longRunningCommandsOverPreviousDefaultLimit_laterCommandsStarted();
+    void execute_coalescingNone_allExecutionsQueued();
+    void execute_coalescingDrop_droppedWhileRunningOrQueued();
+    void execute_coalescingMerge_mergedIntoQueuedExecution();
+    void execute_queueFull_executionsDropped();
+};
+
+}
@@ -5,26 +5,48 @@ namespace libgestures
 
 void TestCondition::init()
 {
-    m_condition = std::make_shared<Condition>(m_normalWindowProvider);
+    WindowInfoProvider::setImplementation(new MockWindowInfoProvider(m_normalWindow));
+    m_condition = std::make_shared<Condition>();
 }
 
 void TestCondition::isSatisfied_noActiveWindow_returnsFalse()
 {
-    QVERIFY(!Condition(m_noActiveWindowProvider).isSatisfied());
+    WindowInfoProvider::setImplementation(new MockWindowInfoProvider(std::nullopt));
+
+    QVERIFY(!Condition().isSatisfied());
 }
 
 void TestCondition::isSatisfied_noSubConditions_returnsTrue()
 {
-    QVERIFY(Condition(m_normalWindowProvider).isSatisfied());
+    QVERIFY(Condition().isSatisfied());
 }
 
 void TestCondition::isSatisfied_negatedAndNoSubConditions_returnsTrue()
 {
-    m_condition->setNegate(true);
+    m_condition->setNegateWindowClass(true);
+    m_condition->setNegateWindowState(true);
 
     QVERIFY(m_condition->isSatisfied());
 }
 
+void TestCondition::isSatisfied_multipleConditions_activeWindowQueriedOnce()
+{
+    auto provider = new MockWindowInfoProvider(m_normalWindow);
+    WindowInfoProvider::setImplementation(provider);
+    Condition condition1;
+    Condition condition2;
+    condition2.setWindowState(WindowState::Maximized);
+
+    condition1.isSatisfied();
+    condition2.isSatisfied();
+    condition1.isSatisfied();
+    QCOMPARE(provider->activeWindowCalls(), 1);
+
+    provider->invalidateActiveWindow();
+    condition2.isSatisfied();
+    QCOMPARE(provider->activeWindowCalls(), 2);
+}
+
 void TestCondition::isWindowClassRegexSubConditionSatisfied_subConditionNotSet_returnsTrue()
 {
     QVERIFY(m_condition->isWindowClassRegexSubConditionSatisfied(m_normalWindow));
@@ -32,7 +54,7 @@ void TestCondition::isWindowClassRegexSubConditionSatisfied_subConditionNotSet_r
 
 void TestCondition::isWindowClassRegexSubConditionSatisfied_negatedAndSubConditionNotSet_returnsTrue()
 {
-    m_condition->setNegate(true);
+    m_condition->setNegateWindowClass(true);
 
     QVERIFY(m_condition->isWindowClassRegexSubConditionSatisfied(m_normalWindow));
 }
@@ -50,6 +72,15 @@ void TestCondition::isWindowClassRegexSubConditionSatisfied_data()
     QTest::newRow("no match") << false << s_windowClass << "" << "" << false;
     QTest::newRow("negated match") << true << s_windowClass << s_windowClass << s_windowClass << false;
     QTest::newRow("negated no match") << true << s_windowClass << "" << "" << true;
+    QTest::newRow("literal contains") << false << "refo" << s_windowClass << "" << true;
+    QTest::newRow("literal equals") << false << "^firefox$" << s_windowClass << "" << true;
+    QTest::newRow("literal equals no match") << false << "^firefo$" << s_windowClass << "" << false;
+    QTest::newRow("literal starts with") << false << "^fire" << "" << s_windowClass << true;
+    QTest::newRow("literal starts with no match") << false << "^fox" << "" << s_windowClass << false;
+    QTest::newRow("literal ends with") << false << "fox$" << s_windowClass << "" << true;
+    QTest::newRow("literal ends with no match") << false << "fire$" << s_windowClass << "" << false;
+    QTest::newRow("regex") << false << "^fire.+x$" << s_windowClass << "" << true;
+    QTest::newRow("regex no match") << false << "^fire.+y$" << s_windowClass << "" << false;
 }
 
 void TestCondition::isWindowClassRegexSubConditionSatisfied()
@@ -59,14 +90,28 @@ void TestCondition::isWindowClassRegexSubConditionSatisfied()
     QFETCH(QString, resourceClass);
     QFETCH(QString, resourceName);
     QFETCH(bool, result);
-    const WindowInfo windowData(s_windowCaption, resourceClass, resourceName, WindowState::Unimportant);
+    const WindowInfo windowData(s_windowCaption, resourceClass, resourceName, WindowStates());
 
-    m_condition->setNegate(negate);
+    m_condition->setNegateWindowClass(negate);
     m_condition->setWindowClass(QRegularExpression(regex));
 
     QCOMPARE(m_condition->isWindowClassRegexSubConditionSatisfied(windowData), result);
 }
 
+void TestCondition::setWindowClass_identicalPatterns_matcherShared()
+{
+    Condition condition1;
+    Condition condition2;
+    Condition condition3;
+
+    condition1.setWindowClass(QRegularExpression(s_windowClass));
+    condition2.setWindowClass(QRegularExpression(s_windowClass));
+    condition3.setWindowClass(QRegularExpression("^" + s_windowClass));
+
+    QCOMPARE(condition1.m_windowClass, condition2.m_windowClass);
+    QVERIFY(condition1.m_windowClass != condition3.m_windowClass);
+}
+
 void TestCondition::isWindowStateSubConditionSatisfied_subConditionNotSet_returnsTrue()
 {
     QVERIFY(m_condition->isWindowStateSubConditionSatisfied(m_normalWindow));
@@ -74,7 +119,7 @@ void TestCondition::isWindowStateSubConditionSatisfied_subConditionNotSet_return
 
 void TestCondition::isWindowStateSubConditionSatisfied_negatedAndSubConditionNotSet_returnsTrue()
 {
-    m_condition->setNegate(true);
+    m_condition->setNegateWindowState(true);
 
     QVERIFY(m_condition->isWindowStateSubConditionSatisfied(m_normalWindow));
 }
@@ -106,7 +151,7 @@ void TestCondition::isWindowStateSubConditionSatisfied()
     QFETCH(bool, result);
     const WindowInfo windowData(s_windowCaption, s_windowClass, s_windowClass, static_cast<WindowState>(windowState));
 
-    m_condition->setNegate(negate);
+    m_condition->setNegateWindowState(negate);
     m_condition->setWindowState(static_cast<WindowState>(conditionWindowState));
 
     QCOMPARE(m_condition->isWindowStateSubConditionSatisfied(windowData), result);
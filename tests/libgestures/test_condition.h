@@ -19,22 +19,22 @@ private slots:
     void isSatisfied_noActiveWindow_returnsFalse();
     void isSatisfied_noSubConditions_returnsTrue();
     void isSatisfied_negatedAndNoSubConditions_returnsTrue();
+    void isSatisfied_multipleConditions_activeWindowQueriedOnce();
 
     void isWindowClassRegexSubConditionSatisfied_subConditionNotSet_returnsTrue();
     void isWindowClassRegexSubConditionSatisfied_negatedAndSubConditionNotSet_returnsTrue();
     void isWindowClassRegexSubConditionSatisfied_data();
     void isWindowClassRegexSubConditionSatisfied();
+    void setWindowClass_identicalPatterns_matcherShared();
 
     void isWindowStateSubConditionSatisfied_subConditionNotSet_returnsTrue();
     void isWindowStateSubConditionSatisfied_negatedAndSubConditionNotSet_returnsTrue();
     void isWindowStateSubConditionSatisfied_data();
     void isWindowStateSubConditionSatisfied();
 private:
-    const std::shared_ptr<MockWindowInfoProvider> m_noActiveWindowProvider = std::make_shared<MockWindowInfoProvider>(std::nullopt);
-    const std::shared_ptr<MockWindowInfoProvider> m_normalWindowProvider = std::make_shared<MockWindowInfoProvider>(std::make_optional<WindowInfo>(s_windowCaption, s_windowClass, s_windowClass, WindowState::Unimportant));
-    const WindowInfo m_normalWindow = m_normalWindowProvider->activeWindow().value();
+    const WindowInfo m_normalWindow = WindowInfo(s_windowCaption, s_windowClass, s_windowClass, WindowStates());
 
-    std::shared_ptr<Condition> m_condition = std::make_shared<Condition>(m_normalWindowProvider);
+    std::shared_ptr<Condition> m_condition;
 };
 
 }
\ No newline at end of file
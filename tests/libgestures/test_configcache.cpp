@@ -0,0 +1,201 @@
+#include "test_configcache.h"
+#include "libgestures/actions/command.h"
+#include "libgestures/actions/input.h"
+#include "libgestures/actions/plasmaglobalshortcut.h"
+
+#include <QFile>
+
+namespace libgestures
+{
+
+void TestConfigCache::init()
+{
+    m_directory = std::make_unique<QTemporaryDir>();
+    m_cache = std::make_unique<ConfigCache>(m_directory->filePath("kwingestures.yml"));
+}
+
+Config TestConfigCache::createConfig()
+{
+    Config config;
+    config.autoReload = false;
+    config.commandConcurrency = 4;
+    config.inputTrace = "/tmp/kwingestures.trace";
+    config.touchpadGestureRecognizer = std::make_shared<GestureRecognizer>();
+    config.touchpadGestureRecognizer->setSwipeFastThreshold(30);
+    config.touchpadGestureRecognizer->setScrollTimeout(250);
+
+    auto condition = std::make_shared<Condition>();
+    condition->setWindowClass(QRegularExpression("firefox"));
+    condition->setNegateWindowClass(true);
+    condition->setWindowState(WindowState::Fullscreen);
+
+    auto swipe = std::make_shared<SwipeGesture>();
+    swipe->setDirection(SwipeDirection::Up);
+    swipe->setFingers(3, 4);
+    swipe->setSpeed(GestureSpeed::Fast);
+    swipe->setThresholds(10, 20);
+    swipe->setKeyboardModifiers(Qt::KeyboardModifier::MetaModifier);
+    swipe->addCondition(condition);
+    swipe->setConfigHash(1);
+
+    auto inputAction = std::make_shared<InputGestureAction>();
+    inputAction->setSequence({InputAction{.keyboardPress = {KEY_LEFTMETA}, .mouseMoveRelativeByDelta = true}});
+    inputAction->setOn(On::Update);
+    inputAction->setRepeatInterval(-5);
+    swipe->addAction(inputAction);
+
+    auto commandAction = std::make_shared<CommandGestureAction>();
+    commandAction->setCommand("notify-send test");
+    commandAction->setCoalescing(CommandCoalescing::Drop);
+    commandAction->addCondition(condition);
+    swipe->addAction(commandAction);
+    config.touchpadGestureRecognizer->registerGesture(swipe);
+
+    auto hold = std::make_shared<HoldGesture>();
+    hold->setFingers(2, 2);
+    hold->setKeyboardModifiers(std::nullopt);
+    hold->setConfigHash(2);
+    auto shortcutAction = std::make_shared<PlasmaGlobalShortcutGestureAction>();
+    shortcutAction->setComponent("kwin");
+    shortcutAction->setShortcut("Window Minimize");
+    shortcutAction->setBlockOtherActions(true);
+    hold->addAction(shortcutAction);
+    config.touchpadGestureRecognizer->registerGesture(hold);
+
+    return config;
+}
+
+QByteArray TestConfigCache::readCache() const
+{
+    QFile file(m_cache->path());
+    file.open(QIODevice::ReadOnly);
+    return file.readAll();
+}
+
+void TestConfigCache::load_noCache_returnsNullopt()
+{
+    QVERIFY(!m_cache->load(m_key));
+}
+
+void TestConfigCache::load_differentKey_returnsNullopt()
+{
+    QVERIFY(m_cache->save(m_key, createConfig()));
+
+    QVERIFY(!m_cache->load({1, 2, "other hash"}));
+    QVERIFY(!m_cache->load({2, 2, m_key.hash}));
+    QVERIFY(!m_cache->load({1, 3, m_key.hash}));
+}
+
+void TestConfigCache::load_corrupted_returnsNullopt()
+{
+    QVERIFY(m_cache->save(m_key, createConfig()));
+    auto data = readCache();
+    data.chop(1);
+    QFile file(m_cache->path());
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write(data);
+    file.close();
+
+    QVERIFY(!m_cache->load(m_key));
+}
+
+void TestConfigCache::load_saved_configRestored()
+{
+    QVERIFY(m_cache->save(m_key, createConfig()));
+
+    const auto config = m_cache->load(m_key);
+    QVERIFY(config);
+    QCOMPARE(config->autoReload, false);
+    QCOMPARE(config->commandConcurrency, 4);
+    QCOMPARE(config->inputTrace, "/tmp/kwingestures.trace");
+    QCOMPARE(config->touchpadGestureRecognizer->m_swipeGestureFastThreshold, 30);
+    QCOMPARE(config->touchpadGestureRecognizer->scrollTimeout(), 250);
+    QCOMPARE(config->touchpadGestureRecognizer->m_gestures.size(), 2);
+
+    const auto swipe = std::dynamic_pointer_cast<SwipeGesture>(config->touchpadGestureRecognizer->m_gestures[0]);
+    QVERIFY(swipe);
+    QCOMPARE(swipe->direction(), SwipeDirection::Up);
+    QCOMPARE(swipe->minimumFingers(), 3);
+    QCOMPARE(swipe->maximumFingers(), 4);
+    QCOMPARE(swipe->speed(), GestureSpeed::Fast);
+    QCOMPARE(swipe->keyboardModifiers(), Qt::KeyboardModifier::MetaModifier);
+
+    const auto hold = config->touchpadGestureRecognizer->m_gestures[1];
+    QCOMPARE(hold->type(), GestureType::Hold);
+    QCOMPARE(hold->keyboardModifiers(), std::nullopt);
+}
+
+void TestConfigCache::load_saved_savingAgainProducesIdenticalCache()
+{
+    QVERIFY(m_cache->save(m_key, createConfig()));
+    const auto saved = readCache();
+
+    QVERIFY(m_cache->save(m_key, m_cache->load(m_key).value()));
+
+    QCOMPARE(readCache(), saved);
+}
+
+void TestConfigCache::load_previousConfig_unchangedGesturesReused()
+{
+    QVERIFY(m_cache->save(m_key, createConfig()));
+    const auto previous = createConfig();
+    previous.touchpadGestureRecognizer->m_gestures[1]->setConfigHash(3);
+
+    const auto config = m_cache->load(m_key, &previous);
+    QVERIFY(config);
+    QCOMPARE(config->touchpadGestureRecognizer->m_gestures.size(), 2);
+    QCOMPARE(config->touchpadGestureRecognizer->m_gestures[0], previous.touchpadGestureRecognizer->m_gestures[0]);
+    QVERIFY(config->touchpadGestureRecognizer->m_gestures[1] != previous.touchpadGestureRecognizer->m_gestures[1]);
+    QCOMPARE(config->touchpadGestureRecognizer->m_gestures[1]->configHash(), 2);
+}
+
+void TestConfigCache::configHash_returnsStableHash()
+{
+    // The hash is stored in the cache, so it must not depend on the standard library
+    QCOMPARE(PreviousGestures::configHash("type: hold"), static_cast<uint64_t>(0x8660fdf9a777ab7c));
+}
+
+void TestConfigCache::load_windowClassPatternOptions_optionsRestored()
+{
+    auto config = createConfig();
+    auto condition = std::make_shared<Condition>();
+    condition->setWindowClass(QRegularExpression("Firefox", QRegularExpression::CaseInsensitiveOption));
+    config.touchpadGestureRecognizer->m_gestures[1]->addCondition(condition);
+    QVERIFY(m_cache->save(m_key, config));
+
+    const auto loadedConfig = m_cache->load(m_key);
+    QVERIFY(loadedConfig);
+    const auto loadedCondition = loadedConfig->touchpadGestureRecognizer->m_gestures[1]->m_conditions[0];
+    QCOMPARE(loadedCondition->m_windowClass->pattern(), "Firefox");
+    QCOMPARE(loadedCondition->m_windowClass->patternOptions(), QRegularExpression::PatternOptions(QRegularExpression::CaseInsensitiveOption));
+    // Conditions with identical patterns and options share the matcher
+    QCOMPARE(loadedCondition->m_windowClass, condition->m_windowClass);
+}
+
+void TestConfigCache::unchangedKey_noCache_returnsNullopt()
+{
+    QVERIFY(!m_cache->unchangedKey());
+}
+
+void TestConfigCache::unchangedKey_configFileUnchangedOrChanged_keyReturnedOnlyIfUnchanged()
+{
+    QFile configFile(m_directory->filePath("kwingestures.yml"));
+    QVERIFY(configFile.open(QIODevice::WriteOnly));
+    configFile.write("gestures: []");
+    configFile.close();
+    const auto key = m_cache->key("gestures: []");
+    QVERIFY(m_cache->save(key, createConfig()));
+
+    QVERIFY(m_cache->unchangedKey() == key);
+
+    QVERIFY(configFile.open(QIODevice::Append));
+    configFile.write("\n");
+    configFile.close();
+
+    QVERIFY(!m_cache->unchangedKey());
+}
+
+}
+
+QTEST_MAIN(libgestures::TestConfigCache)
+#include "test_configcache.moc"
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "libgestures/configcache.h"
+#include <QTemporaryDir>
+#include <QTest>
+
+namespace libgestures
+{
+
+class TestConfigCache : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+
+    void load_noCache_returnsNullopt();
+    void load_differentKey_returnsNullopt();
+    void load_corrupted_returnsNullopt();
+    void load_saved_configRestored();
+    void load_saved_savingAgainProducesIdenticalCache();
+    void load_previousConfig_unchangedGesturesReused();
+    void configHash_returnsStableHash();
+    void load_windowClassPatternOptions_optionsRestored();
+
+    void unchangedKey_noCache_returnsNullopt();
+    void unchangedKey_configFileUnchangedOrChanged_keyReturnedOnlyIfUnchanged();
+private:
+    static Config createConfig();
+    QByteArray readCache() const;
+
+    std::unique_ptr<QTemporaryDir> m_directory;
+    std::unique_ptr<ConfigCache> m_cache;
+    const ConfigCache::Key m_key{1, 2, "hash"};
+};
+
+}
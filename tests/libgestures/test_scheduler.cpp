@@ -0,0 +1,132 @@
+#include "test_scheduler.h"
+
+namespace libgestures
+{
+
+/**
+ * Records the times the timer is armed for instead of arming one.
+ */
+class MockScheduler : public Scheduler
+{
+public:
+    std::vector<std::chrono::microseconds> m_armed;
+
+protected:
+    void armTimer(const std::chrono::microseconds &deadline) override
+    {
+        m_armed.push_back(deadline);
+    }
+};
+
+void TestScheduler::init()
+{
+    m_clock = new VirtualClock;
+    Clock::setImplementation(m_clock);
+}
+
+void TestScheduler::schedule_laterDeadline_timerNotRearmed()
+{
+    MockScheduler scheduler;
+    const auto task = scheduler.addTask([]() {});
+
+    scheduler.schedule(task, std::chrono::milliseconds(100));
+    scheduler.schedule(task, std::chrono::milliseconds(110));
+    scheduler.schedule(task, std::chrono::milliseconds(120));
+
+    QCOMPARE(scheduler.m_armed, std::vector<std::chrono::microseconds>{std::chrono::milliseconds(100)});
+}
+
+void TestScheduler::schedule_earlierDeadline_timerRearmed()
+{
+    MockScheduler scheduler;
+    const auto task1 = scheduler.addTask([]() {});
+    const auto task2 = scheduler.addTask([]() {});
+
+    scheduler.schedule(task1, std::chrono::milliseconds(100));
+    scheduler.schedule(task2, std::chrono::milliseconds(50));
+
+    QCOMPARE(scheduler.m_armed.size(), 2);
+    QCOMPARE(scheduler.m_armed.back(), std::chrono::milliseconds(50));
+}
+
+void TestScheduler::run_noTaskDue_timerRearmedForEarliestDeadline()
+{
+    MockScheduler scheduler;
+    auto runs = 0;
+    const auto task = scheduler.addTask([&runs]() {
+        runs++;
+    });
+    scheduler.schedule(task, std::chrono::milliseconds(100));
+    scheduler.schedule(task, std::chrono::milliseconds(150));
+
+    m_clock->setTime(std::chrono::milliseconds(100));
+    scheduler.run();
+
+    QCOMPARE(runs, 0);
+    QCOMPARE(scheduler.m_armed.back(), std::chrono::milliseconds(150));
+}
+
+void TestScheduler::run_taskDue_taskRunOnceAndUnscheduled()
+{
+    MockScheduler scheduler;
+    auto runs = 0;
+    const auto task = scheduler.addTask([&runs]() {
+        runs++;
+    });
+    scheduler.schedule(task, std::chrono::milliseconds(100));
+
+    m_clock->setTime(std::chrono::milliseconds(100));
+    scheduler.run();
+    scheduler.run();
+
+    QCOMPARE(runs, 1);
+    QVERIFY(!scheduler.isScheduled(task));
+    QCOMPARE(scheduler.nextDeadline(), std::nullopt);
+}
+
+void TestScheduler::advance_multipleTasks_tasksRunInDeadlineOrderAtTheirDeadlines()
+{
+    Scheduler scheduler;
+    std::vector<std::pair<int, std::chrono::microseconds>> runs;
+    const auto task1 = scheduler.addTask([this, &runs]() {
+        runs.emplace_back(1, m_clock->now());
+    });
+    const auto task2 = scheduler.addTask([this, &runs]() {
+        runs.emplace_back(2, m_clock->now());
+    });
+    scheduler.schedule(task1, std::chrono::milliseconds(30));
+    scheduler.schedule(task2, std::chrono::milliseconds(20));
+
+    m_clock->advance(std::chrono::milliseconds(25), &scheduler);
+    QCOMPARE(runs.size(), 1);
+
+    m_clock->advance(std::chrono::milliseconds(25), &scheduler);
+    QCOMPARE(runs.size(), 2);
+    QCOMPARE(runs[0].first, 2);
+    QCOMPARE(runs[0].second, std::chrono::milliseconds(20));
+    QCOMPARE(runs[1].first, 1);
+    QCOMPARE(runs[1].second, std::chrono::milliseconds(30));
+    QCOMPARE(m_clock->now(), std::chrono::milliseconds(50));
+}
+
+void TestScheduler::advance_taskReschedulesItself_runUntilEndOfDuration()
+{
+    Scheduler scheduler;
+    auto runs = 0;
+    Scheduler::TaskId task;
+    task = scheduler.addTask([this, &scheduler, &task, &runs]() {
+        runs++;
+        scheduler.schedule(task, m_clock->now() + std::chrono::seconds(1));
+    });
+    scheduler.schedule(task, std::chrono::seconds(1));
+
+    // 10 hours
+    m_clock->advance(std::chrono::hours(10), &scheduler);
+
+    QCOMPARE(runs, 36000);
+}
+
+}
+
+QTEST_MAIN(libgestures::TestScheduler)
+#include "test_scheduler.moc"
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "libgestures/clock.h"
+#include "libgestures/scheduler.h"
+#include <QTest>
+
+namespace libgestures
+{
+
+class TestScheduler : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+
+    void schedule_laterDeadline_timerNotRearmed();
+    void schedule_earlierDeadline_timerRearmed();
+    void run_noTaskDue_timerRearmedForEarliestDeadline();
+    void run_taskDue_taskRunOnceAndUnscheduled();
+    void advance_multipleTasks_tasksRunInDeadlineOrderAtTheirDeadlines();
+    void advance_taskReschedulesItself_runUntilEndOfDuration();
+
+private:
+    VirtualClock *m_clock;
+};
+
+}
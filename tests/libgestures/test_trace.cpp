@@ -0,0 +1,69 @@
+#include "test_trace.h"
+
+#include <QFile>
+
+namespace libgestures
+{
+
+void TestTrace::init()
+{
+    m_directory = std::make_unique<QTemporaryDir>();
+}
+
+void TestTrace::readTrace_recorded_recordsRestoredInOrder()
+{
+    const auto path = m_directory->filePath("trace");
+    {
+        TraceRecorder recorder(path);
+        QVERIFY(recorder.isOpen());
+        recorder.record({.time = 1, .type = TraceEventType::SwipeBegin, .fingers = 3});
+        // More records than the buffer can hold, so that the worker thread has to wrap around
+        for (uint64_t i = 0; i < 20000; i++) {
+            recorder.record({.time = 2 + i, .deltaX = 1, .deltaY = -2, .type = TraceEventType::SwipeUpdate});
+            if (i % 4000 == 0) {
+                QTest::qWait(300);
+            }
+        }
+        recorder.record({.time = 20002, .type = TraceEventType::SwipeEnd});
+        QCOMPARE(recorder.dropped(), 0);
+    }
+
+    const auto records = readTrace(path);
+    QVERIFY(records);
+    QCOMPARE(records->size(), 20002);
+    QCOMPARE(records->front().type, TraceEventType::SwipeBegin);
+    QCOMPARE(records->front().fingers, 3);
+    for (size_t i = 1; i < records->size() - 1; i++) {
+        QCOMPARE((*records)[i].time, i + 1);
+        QCOMPARE((*records)[i].deltaY, -2);
+    }
+    QCOMPARE(records->back().type, TraceEventType::SwipeEnd);
+}
+
+void TestTrace::readTrace_notATrace_returnsNullopt()
+{
+    const auto path = m_directory->filePath("trace");
+    QFile file(path);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    file.write("autoreload: false\n");
+    file.close();
+
+    QVERIFY(!readTrace(path));
+}
+
+void TestTrace::record_bufferFull_recordsDropped()
+{
+    const auto path = m_directory->filePath("trace");
+    TraceRecorder recorder(path);
+    // The worker thread only writes every 250 ms
+    for (uint64_t i = 0; i < 10000; i++) {
+        recorder.record({.time = i});
+    }
+
+    QVERIFY(recorder.dropped() > 0);
+}
+
+}
+
+QTEST_MAIN(libgestures::TestTrace)
+#include "test_trace.moc"
@@ -0,0 +1,24 @@
+#pragma once
+
+#include "libgestures/trace.h"
+#include <QTemporaryDir>
+#include <QTest>
+
+namespace libgestures
+{
+
+class TestTrace : public QObject
+{
+    Q_OBJECT
+private slots:
+    void init();
+
+    void readTrace_recorded_recordsRestoredInOrder();
+    void readTrace_notATrace_returnsNullopt();
+    void record_bufferFull_recordsDropped();
+
+private:
+    std::unique_ptr<QTemporaryDir> m_directory;
+};
+
+}